@@ -25,7 +25,6 @@ namespace kodo
                uniform_generator<
                // Codec API
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                storage_aware_encoder<
                // Coefficient Storage API
@@ -42,7 +41,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                full_rlnc_encoder_count<Field>
-                   > > > > > > > > > > > > > > > > >
+                   > > > > > > > > > > > > > > > >
     { };
 
     template<class Field>
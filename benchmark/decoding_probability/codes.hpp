@@ -86,7 +86,6 @@ namespace kodo
                uniform_generator<
                // Codec API
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                storage_aware_encoder<
                // Coefficient Storage API
@@ -102,7 +101,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                full_rlnc_encoder_unsystematic<Field
-                   > > > > > > > > > > > > > > > >
+                   > > > > > > > > > > > > > > >
     { };
 
     /// RLNC encoder using a density based random generator, which can be
@@ -121,7 +120,6 @@ namespace kodo
                sparse_uniform_generator<
                // Codec API
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                storage_aware_encoder<
                // Coefficient Storage API
@@ -137,7 +135,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                sparse_full_rlnc_encoder<Field
-                   > > > > > > > > > > > > > > > > >
+                   > > > > > > > > > > > > > > > >
     { };
 
 }
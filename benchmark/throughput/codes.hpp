@@ -65,7 +65,6 @@ namespace kodo
                sparse_uniform_generator<
                // Codec API
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                storage_aware_encoder<
                // Coefficient Storage API
@@ -81,7 +80,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                sparse_full_rlnc_encoder<Field
-                   > > > > > > > > > > > > > > > > >
+                   > > > > > > > > > > > > > > > >
     { };
 
     /// RLNC decoder which uses the policy based linear block decoder
@@ -38,7 +38,6 @@ namespace kodo
                // Codec API
                storage_aware_encoder<
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                // Coefficient Storage API
                coefficient_info<
@@ -53,7 +52,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                full_rlnc_encoder<Field>
-               > > > > > > > > > > > > > > > >
+               > > > > > > > > > > > > > > >
     { };
 
     /// Decoder stack with shallow storage as required by the
@@ -112,7 +111,7 @@ int main()
     storage_decoder::factory decoder_factory(max_symbols, max_symbol_size);
 
     // The storage needed for all decoders
-    uint32_t total_block_size =
+    uint64_t total_block_size =
         decoder_factory.total_block_size(object_size);
 
     std::vector<uint8_t> data_out(total_block_size, '\0');
@@ -33,7 +33,6 @@ namespace kodo
                  uniform_generator<
                  // Codec API
                  encode_symbol_tracker<
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  storage_aware_encoder<         // <--- New layer
                  // Coefficient Storage API
@@ -49,7 +48,7 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  on_the_fly_encoder<Field>
-                     > > > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > > >
     { };
 }
 
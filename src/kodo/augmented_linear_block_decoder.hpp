@@ -0,0 +1,543 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <sak/storage.hpp>
+#include <sak/aligned_allocator.hpp>
+
+#include <fifi/arithmetics.hpp>
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include <kodo/forward_linear_block_decoder_policy.hpp>
+#include <kodo/backward_linear_block_decoder_policy.hpp>
+#include <kodo/pivot_bitmap.hpp>
+
+namespace kodo
+{
+    /// @ingroup codec_layers
+    /// @brief Linear block decoder operating on augmented rows.
+    ///
+    /// Works like the bidirectional_linear_block_decoder, but requires
+    /// that the coefficients and the symbol data of every stored symbol
+    /// are placed in one augmented row as done by the
+    /// augmented_symbol_storage layer. An incoming symbol is copied
+    /// into a temporary augmented row after which every elimination
+    /// step is carried out using a single finite field operation
+    /// covering both the coefficients and the symbol data. This halves
+    /// the number of row operations compared to the
+    /// bidirectional_linear_block_decoder, which is beneficial when
+    /// the symbols are small.
+    template<class DirectionPolicy, class SuperCoder>
+    class augmented_linear_block_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// @copydoc layer::factory
+        typedef typename SuperCoder::factory factory;
+
+        /// The direction policy used
+        typedef DirectionPolicy direction_policy;
+
+    public:
+
+        /// Constructor
+        augmented_linear_block_decoder()
+            : m_rank(0),
+              m_maximum_pivot(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_uncoded.resize(the_factory.max_symbols());
+            m_coded.resize(the_factory.max_symbols());
+            m_pivots.resize(the_factory.max_symbols());
+
+            uint32_t max_augmented_length =
+                fifi::size_to_length<field_type>(
+                    the_factory.max_augmented_size());
+
+            m_row.resize(max_augmented_length, 0);
+            m_temp_row.resize(max_augmented_length, 0);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_uncoded.reset(the_factory.symbols());
+            m_coded.reset(the_factory.symbols());
+            m_pivots.reset(the_factory.symbols());
+
+            // The padding between the coefficients and the symbol data
+            // must be zero
+            std::fill(m_row.begin(), m_row.end(), 0);
+
+            m_rank = 0;
+
+            // Depending on the policy we either go from 0 to symbols or
+            // from symbols to 0.
+            m_maximum_pivot =
+                direction_policy::min(0, the_factory.symbols() - 1);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data,
+                           uint8_t *symbol_coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_coefficients != 0);
+
+            // Build the augmented row of the incoming symbol
+            uint8_t *row = reinterpret_cast<uint8_t*>(&m_row[0]);
+
+            sak::copy_storage(
+                sak::storage(row, SuperCoder::coefficients_size()),
+                sak::storage(symbol_coefficients,
+                             SuperCoder::coefficients_size()));
+
+            row += SuperCoder::augmented_symbol_offset();
+
+            sak::copy_storage(
+                sak::storage(row, SuperCoder::symbol_size()),
+                sak::storage(symbol_data, SuperCoder::symbol_size()));
+
+            decode_row(&m_row[0]);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*, uint32_t)
+        void decode_symbol(uint8_t *symbol_data,
+                           uint32_t symbol_index)
+        {
+            assert(symbol_index < SuperCoder::symbols());
+            assert(symbol_data != 0);
+
+            if(m_uncoded[symbol_index])
+            {
+                return;
+            }
+
+            const value_type *symbol
+                = reinterpret_cast<value_type*>( symbol_data );
+
+            if(m_coded[symbol_index])
+            {
+                swap_decode(symbol, symbol_index);
+            }
+            else
+            {
+                // Stores the symbol and updates the corresponding
+                // encoding vector
+                store_uncoded_symbol(symbol, symbol_index);
+
+                // Backwards substitution
+                backward_substitute(
+                    SuperCoder::augmented_value(symbol_index),
+                    symbol_index);
+
+                // We have increased the rank if we have finished the
+                // backwards substitution
+                ++m_rank;
+
+                m_uncoded.set(symbol_index);
+                m_pivots.set(symbol_index);
+
+                m_maximum_pivot =
+                    direction_policy::max(symbol_index, m_maximum_pivot);
+            }
+        }
+
+        /// @copydoc layer::is_complete() const
+        bool is_complete() const
+        {
+            return m_rank == SuperCoder::symbols();
+        }
+
+        /// @copydoc layer::rank() const
+        uint32_t rank() const
+        {
+            return m_rank;
+        }
+
+        /// @copydoc layer::symbol_pivot(uint32_t) const
+        bool symbol_pivot(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+            return m_pivots[index];
+        }
+
+        /// @copydoc layer::symbol_pivots() const
+        const pivot_bitmap& symbol_pivots() const
+        {
+            return m_pivots;
+        }
+
+        /// @copydoc layer::symbol_coded(uint32_t) const
+        bool symbol_coded(uint32_t index) const
+        {
+            assert(symbol_pivot(index));
+            return m_coded[index];
+        }
+
+    protected:
+
+        /// Decodes an augmented row
+        /// @param row the augmented row of the encoded symbol
+        void decode_row(value_type *row)
+        {
+            assert(row != 0);
+
+            // See if we can find a pivot
+            auto pivot_index = forward_substitute_to_pivot(row);
+
+            if(!pivot_index)
+                return;
+
+            if(!fifi::is_binary<field_type>::value)
+            {
+                // Normalize the row
+                normalize(row, *pivot_index);
+            }
+
+            // Reduce the row further
+            forward_substitute_from_pivot(row, *pivot_index);
+
+            // Now with the found pivot reduce the existing rows
+            backward_substitute(row, *pivot_index);
+
+            // Now save the received row
+            store_coded_row(row, *pivot_index);
+
+            // We have increased the rank
+            ++m_rank;
+
+            m_coded.set(*pivot_index);
+            m_pivots.set(*pivot_index);
+
+            m_maximum_pivot =
+                direction_policy::max(*pivot_index, m_maximum_pivot);
+        }
+
+        /// When adding a raw symbol (i.e. uncoded) with a specific
+        /// pivot id and the decoder already contains a coded symbol
+        /// in that position this function performs the proper swap
+        /// between the two symbols.
+        /// @param symbol_data the data for the raw symbol
+        /// @param pivot_index the pivot position of the raw symbol
+        void swap_decode(const value_type *symbol_data,
+                         uint32_t pivot_index)
+        {
+            assert(m_coded[pivot_index] == true);
+            assert(m_uncoded[pivot_index] == false);
+
+            m_coded.clear(pivot_index);
+
+            value_type *row_i =
+                SuperCoder::augmented_value(pivot_index);
+
+            value_type value =
+                fifi::get_value<field_type>(row_i, pivot_index);
+
+            assert(value == 1);
+
+            // Subtract the new pivot symbol
+            fifi::set_value<field_type>(row_i, pivot_index, 0);
+
+            SuperCoder::subtract(SuperCoder::symbol_value(pivot_index),
+                                 symbol_data, SuperCoder::symbol_length());
+
+            // Now continue our new coded symbol we know that it must
+            // if found it will contain a pivot id > that the current.
+            decode_row(row_i);
+
+            // Stores the symbol and sets the pivot in the vector
+            store_uncoded_symbol(symbol_data, pivot_index);
+
+            m_uncoded.set(pivot_index);
+
+            // No need to backwards substitute since we are
+            // replacing an existing symbol. I.e. backwards
+            // substitution must already have been done.
+        }
+
+        /// Normalizes the row so that the pivot coefficient becomes one
+        /// @param row the augmented row of the encoded symbol
+        /// @param pivot_index the index of the found pivot element
+        void normalize(value_type *row, uint32_t pivot_index)
+        {
+            assert(row != 0);
+            assert(pivot_index < SuperCoder::symbols());
+
+            assert(m_uncoded[pivot_index] == false);
+            assert(m_coded[pivot_index] == false);
+
+            value_type coefficient =
+                fifi::get_value<field_type>(row, pivot_index);
+
+            assert(coefficient > 0);
+
+            value_type inverted_coefficient =
+                SuperCoder::invert(coefficient);
+
+            // Update both the coefficients and the symbol
+            SuperCoder::multiply(row, inverted_coefficient,
+                                 SuperCoder::augmented_length());
+        }
+
+        /// Iterates the coefficients of the row and subtracts existing
+        /// rows until a pivot element is found.
+        /// @param row the augmented row of the encoded symbol
+        /// @return the pivot index if found.
+        boost::optional<uint32_t> forward_substitute_to_pivot(
+            value_type *row)
+        {
+            assert(row != 0);
+
+            uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            for(direction_policy p(start, end); !p.at_end(); p.advance())
+            {
+                uint32_t i = p.index();
+
+                value_type current_coefficient
+                    = fifi::get_value<field_type>(row, i);
+
+                if( current_coefficient )
+                {
+                    // If symbol exists
+                    if( symbol_pivot( i ) )
+                    {
+                        subtract_row(row, SuperCoder::augmented_value(i),
+                                     current_coefficient);
+                    }
+                    else
+                    {
+                        return boost::optional<uint32_t>( i );
+                    }
+                }
+            }
+
+            return boost::none;
+        }
+
+        /// Iterates the coefficients of the row from where a pivot has
+        /// been identified and subtracts existing rows
+        /// @param row the augmented row of the encoded symbol
+        /// @param pivot_index the index of the found pivot element
+        void forward_substitute_from_pivot(value_type *row,
+                                           uint32_t pivot_index)
+        {
+            assert(row != 0);
+            assert(pivot_index < SuperCoder::symbols());
+
+            assert(m_uncoded[pivot_index] == false);
+            assert(m_coded[pivot_index] == false);
+
+            // If this pivot index was smaller than the maximum pivot
+            // index we have, we might also need to backward
+            // substitute the higher pivot values into the new packet
+            uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
+
+            direction_policy p(pivot_index, end);
+
+            // Jump past the pivot_index position
+            p.advance();
+
+            for(; !p.at_end(); p.advance())
+            {
+                uint32_t i = p.index();
+
+                // Do we have a non-zero value here?
+                value_type value = fifi::get_value<field_type>(row, i);
+
+                if( !value )
+                {
+                    continue;
+                }
+
+                if( symbol_pivot(i) )
+                {
+                    subtract_row(row, SuperCoder::augmented_value(i), value);
+                }
+            }
+        }
+
+        /// Backward substitute the found row into the existing rows.
+        /// @param row the augmented row of the symbol
+        /// @param pivot_index the pivot index of the row
+        void backward_substitute(const value_type *row,
+                                 uint32_t pivot_index)
+        {
+            assert(row != 0);
+            assert(pivot_index < SuperCoder::symbols());
+
+            // We found a "1" that nobody else had as pivot, we now
+            // substract this row from other coded rows
+            // - if they have a "1" on our pivot place. The uncoded rows
+            // have no non-zero elements outside the pivot position so
+            // only the coded rows are visited.
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t i = m_coded.find_next(0); i < symbols;
+                i = m_coded.find_next(i + 1))
+            {
+                if(i == pivot_index)
+                {
+                    // We cannot backward substitute into ourself
+                    continue;
+                }
+
+                value_type *row_i = SuperCoder::augmented_value(i);
+
+                value_type value =
+                    fifi::get_value<field_type>(row_i, pivot_index);
+
+                if( value )
+                {
+                    subtract_row(row_i, row, value);
+                }
+            }
+        }
+
+        /// Subtracts a multiple of the source row from the destination
+        /// row, both the coefficients and the symbol data are updated.
+        /// @param row_dest the augmented row to update
+        /// @param row_src the augmented row to subtract
+        /// @param coefficient the multiplicative constant
+        void subtract_row(value_type *row_dest, const value_type *row_src,
+                          value_type coefficient)
+        {
+            assert(row_dest != 0);
+            assert(row_src != 0);
+            assert(row_dest != row_src);
+            assert(coefficient > 0);
+
+            uint32_t length = SuperCoder::augmented_length();
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::subtract(row_dest, row_src, length);
+            }
+            else
+            {
+                // The augmented row is longer than the temporary symbol
+                // of the finite_field_math layer, so we pass our own
+                // temporary row to the field operation
+                fifi::multiply_subtract(
+                    SuperCoder::field(), coefficient, row_dest, row_src,
+                    &m_temp_row[0], length);
+            }
+        }
+
+        /// Store an augmented row with the specified pivot found.
+        /// @param row the augmented row of the symbol
+        /// @param pivot_index the pivot index
+        void store_coded_row(const value_type *row, uint32_t pivot_index)
+        {
+            assert(m_uncoded[pivot_index] == false);
+            assert(m_coded[pivot_index] == false);
+            assert(row != 0);
+            assert(SuperCoder::is_symbol_available(pivot_index));
+
+            sak::mutable_storage dest =
+                sak::storage(SuperCoder::augmented_value(pivot_index),
+                             SuperCoder::augmented_size());
+
+            sak::const_storage src =
+                sak::storage(row, SuperCoder::augmented_size());
+
+            sak::copy_storage(dest, src);
+        }
+
+        /// Stores an uncoded or fully decoded symbol
+        /// @param symbol_data the data for the symbol
+        /// @param pivot_index the pivot index of the symbol
+        void store_uncoded_symbol(const value_type *symbol_data,
+                                  uint32_t pivot_index)
+        {
+            assert(symbol_data != 0);
+            assert(m_uncoded[pivot_index] == false);
+            assert(m_coded[pivot_index] == false);
+            assert(SuperCoder::is_symbol_available(pivot_index));
+
+            // Update the corresponding vector
+            value_type *vector_dest =
+                SuperCoder::coefficients_value( pivot_index );
+
+            // Zero out the memory first
+            std::fill_n(vector_dest, SuperCoder::coefficients_length(), 0);
+
+            fifi::set_value<field_type>(vector_dest, pivot_index, 1U);
+
+            // Copy it into the symbol storage
+            sak::mutable_storage dest =
+                sak::storage(SuperCoder::symbol(pivot_index),
+                             SuperCoder::symbol_size());
+
+            sak::const_storage src =
+                sak::storage(symbol_data, SuperCoder::symbol_size());
+
+            sak::copy_storage(dest, src);
+        }
+
+    protected:
+
+        /// The current rank of the decoder
+        uint32_t m_rank;
+
+        /// Stores the current maximum pivot index
+        uint32_t m_maximum_pivot;
+
+        /// Tracks whether a symbol is contained which
+        /// is fully decoded
+        pivot_bitmap m_uncoded;
+
+        /// Tracks whether a symbol is partially decoded
+        pivot_bitmap m_coded;
+
+        /// Tracks the pivots i.e. the symbols which are either
+        /// partially or fully decoded
+        pivot_bitmap m_pivots;
+
+        /// The storage type
+        typedef std::vector<value_type, sak::aligned_allocator<value_type> >
+            aligned_vector;
+
+        /// The augmented row of the incoming symbol
+        aligned_vector m_row;
+
+        /// Temporary row used for the row operations
+        aligned_vector m_temp_row;
+    };
+
+    /// @ingroup codec_layers
+    /// @brief Augmented linear block decoder searching for pivots
+    ///        from the left of the coefficient vector.
+    template<class SuperCoder>
+    class forward_augmented_linear_block_decoder :
+        public augmented_linear_block_decoder<
+            forward_linear_block_decoder_policy, SuperCoder>
+    { };
+
+}
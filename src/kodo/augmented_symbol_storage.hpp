@@ -0,0 +1,398 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/fifi_utils.hpp>
+
+#include <sak/storage.hpp>
+#include <sak/aligned_allocator.hpp>
+
+#include "padded_size.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup symbol_storage_layers
+    /// @brief Deep storage which keeps the coding coefficients and the
+    ///        symbol data of every symbol in one contiguous row.
+    ///
+    /// The layer implements both the Symbol Storage API and the
+    /// Coefficient Storage API and replaces the deep_symbol_storage
+    /// and coefficient_storage layers in a stack. Every symbol is
+    /// stored as an augmented row using the following layout:
+    ///
+    /// @code
+    ///   +----------------+---------+---------------+---------+
+    ///   |  coefficients  | padding |  symbol data  | padding |
+    ///   +----------------+---------+---------------+---------+
+    ///   ^                          ^                         ^
+    ///   |                          |                         |
+    ///   coefficients(i)            symbol(i)       coefficients(i + 1)
+    /// @endcode
+    ///
+    /// Both parts of a row are aligned and the padding is always zero,
+    /// which means that a decoder may update the coefficients and the
+    /// symbol data of a row using a single finite field operation over
+    /// layer::augmented_length() elements. See the
+    /// augmented_linear_block_decoder layer.
+    template<class SuperCoder>
+    class augmented_symbol_storage : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// The alignment in bytes of the coefficients and symbol data
+        static const uint32_t alignment = buffer_alignment;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder.
+        class factory : public SuperCoder::factory
+        {
+        public:
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size)
+                : SuperCoder::factory(max_symbols, max_symbol_size)
+            { }
+
+            /// @return The maximum number of bytes of an augmented row
+            ///         which are updated by a row operation
+            uint32_t max_augmented_size() const
+            {
+                return padded_size(
+                    SuperCoder::factory::max_coefficients_size()) +
+                    SuperCoder::factory::max_symbol_size();
+            }
+        };
+
+    public:
+
+        /// Constructor
+        augmented_symbol_storage()
+            : m_symbol_offset(0),
+              m_augmented_size(0),
+              m_stride(0),
+              m_symbols_count(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            uint32_t max_stride =
+                padded_size(the_factory.max_augmented_size());
+
+            uint32_t max_data_needed = the_factory.max_symbols() * max_stride;
+            assert(max_data_needed > 0);
+
+            // Construct should only be called once so
+            // m_data.size() should be zero
+            assert(m_data.size() == 0);
+            m_data.resize(max_data_needed, 0);
+
+            m_symbols.resize(the_factory.max_symbols(), false);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_symbol_offset = padded_size(SuperCoder::coefficients_size());
+
+            m_augmented_size = m_symbol_offset + SuperCoder::symbol_size();
+            m_stride = padded_size(m_augmented_size);
+
+            assert(SuperCoder::symbols() * m_stride <= m_data.size());
+
+            // The row operations of the decoder rely on the padding
+            // between the coefficients and the symbol data being zero.
+            // Only the rows of the current block are used.
+            std::fill_n(m_data.begin(), SuperCoder::symbols() * m_stride, 0);
+            std::fill_n(m_symbols.begin(), SuperCoder::symbols(), false);
+
+            m_symbols_count = 0;
+        }
+
+        //------------------------------------------------------------------
+        // COEFFICIENT STORAGE API
+        //------------------------------------------------------------------
+
+        /// @copydoc layer::coefficients(uint32_t)
+        uint8_t* coefficients(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            return &m_data[index * m_stride];
+        }
+
+        /// @copydoc layer::coefficients(uint32_t) const
+        const uint8_t* coefficients(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+            return &m_data[index * m_stride];
+        }
+
+        /// @copydoc layer::coefficients_value(uint32_t)
+        value_type* coefficients_value(uint32_t index)
+        {
+            return reinterpret_cast<value_type*>(coefficients(index));
+        }
+
+        /// @copydoc layer::coefficients_value(uint32_t) const
+        const value_type* coefficients_value(uint32_t index) const
+        {
+            return reinterpret_cast<const value_type*>(coefficients(index));
+        }
+
+        /// @copydoc layer::set_coefficients(
+        ///              uint32_t,const sak::const_storage&)
+        void set_coefficients(uint32_t index,
+                              const sak::const_storage &storage)
+        {
+            assert(storage.m_size == SuperCoder::coefficients_size());
+            assert(storage.m_data != 0);
+
+            auto dest = sak::storage(
+                coefficients(index), SuperCoder::coefficients_size());
+
+            sak::copy_storage(dest, storage);
+        }
+
+        //------------------------------------------------------------------
+        // AUGMENTED ROW API
+        //------------------------------------------------------------------
+
+        /// @param index the index of the augmented row
+        /// @return The augmented row i.e. the coefficients followed by
+        ///         the symbol data of the symbol
+        value_type* augmented_value(uint32_t index)
+        {
+            return coefficients_value(index);
+        }
+
+        /// @param index the index of the augmented row
+        /// @return The augmented row i.e. the coefficients followed by
+        ///         the symbol data of the symbol
+        const value_type* augmented_value(uint32_t index) const
+        {
+            return coefficients_value(index);
+        }
+
+        /// @return The offset in bytes of the symbol data within an
+        ///         augmented row
+        uint32_t augmented_symbol_offset() const
+        {
+            return m_symbol_offset;
+        }
+
+        /// @return The number of bytes of an augmented row that must be
+        ///         updated by a row operation
+        uint32_t augmented_size() const
+        {
+            return m_augmented_size;
+        }
+
+        /// @return The number of layer::value_type elements of an
+        ///         augmented row that must be updated by a row operation
+        uint32_t augmented_length() const
+        {
+            return fifi::size_to_length<field_type>(m_augmented_size);
+        }
+
+        //------------------------------------------------------------------
+        // SYMBOL STORAGE API
+        //------------------------------------------------------------------
+
+        /// @copydoc layer::symbol(uint32_t)
+        uint8_t* symbol(uint32_t index)
+        {
+            return coefficients(index) + m_symbol_offset;
+        }
+
+        /// @copydoc layer::symbol(uint32_t) const
+        const uint8_t* symbol(uint32_t index) const
+        {
+            return coefficients(index) + m_symbol_offset;
+        }
+
+        /// @copydoc layer::symbol_value(uint32_t)
+        value_type* symbol_value(uint32_t index)
+        {
+            return reinterpret_cast<value_type*>(symbol(index));
+        }
+
+        /// @copydoc layer::symbol_value(uint32_t) const
+        const value_type* symbol_value(uint32_t index) const
+        {
+            return reinterpret_cast<const value_type*>(symbol(index));
+        }
+
+        /// @copydoc layer::set_symbols(const sak::const_storage&)
+        void set_symbols(const sak::const_storage &symbol_storage)
+        {
+            assert(symbol_storage.m_size > 0);
+            assert(symbol_storage.m_data != 0);
+            assert(symbol_storage.m_size <=
+                   SuperCoder::symbols() * SuperCoder::symbol_size());
+
+            auto symbol_sequence = sak::split_storage(
+                symbol_storage, SuperCoder::symbol_size());
+
+            for(uint32_t i = 0; i < symbol_sequence.size(); ++i)
+            {
+                auto dest = sak::storage(symbol(i), SuperCoder::symbol_size());
+                sak::copy_storage(dest, symbol_sequence[i]);
+            }
+
+            // This will specify all symbols, also in the case
+            // of partial data. If this is not desired then the
+            // symbols need to be set individually.
+            m_symbols_count = SuperCoder::symbols();
+            std::fill(m_symbols.begin(), m_symbols.end(), true);
+        }
+
+        /// @copydoc layer::set_symbol(uint32_t, const sak::const_storage&)
+        void set_symbol(uint32_t index, const sak::const_storage &symbol_data)
+        {
+            assert(symbol_data.m_data != 0);
+
+            // As with the deep storage we allow that the symbol does
+            // not have the full size
+            assert(symbol_data.m_size <= SuperCoder::symbol_size());
+            assert(symbol_data.m_size > 0);
+
+            assert(index < SuperCoder::symbols());
+
+            auto dest = sak::storage(symbol(index), SuperCoder::symbol_size());
+            sak::copy_storage(dest, symbol_data);
+
+            if(m_symbols[index] == false)
+            {
+                ++m_symbols_count;
+                m_symbols[index] = true;
+            }
+        }
+
+        /// @copydoc layer::copy_symbols(const sak::mutable_storage&)
+        void copy_symbols(const sak::mutable_storage &dest_storage) const
+        {
+            assert(dest_storage.m_size > 0);
+            assert(dest_storage.m_data != 0);
+
+            uint32_t data_to_copy =
+                std::min(dest_storage.m_size, SuperCoder::block_size());
+
+            sak::mutable_storage dest = dest_storage;
+            dest.m_size = data_to_copy;
+
+            // The symbols are not stored back to back so we copy them
+            // one at a time
+            for(uint32_t i = 0; dest.m_size > 0; ++i)
+            {
+                uint32_t copy_size =
+                    std::min(dest.m_size, SuperCoder::symbol_size());
+
+                sak::copy_storage(dest, sak::storage(symbol(i), copy_size));
+                dest += copy_size;
+            }
+        }
+
+        /// @copydoc layer::copy_symbol(uint32_t,
+        ///                             const sak::mutable_storage&)
+        void copy_symbol(uint32_t index,
+                         const sak::mutable_storage &dest) const
+        {
+            assert(dest.m_size > 0);
+            assert(dest.m_data != 0);
+
+            uint32_t data_to_copy =
+                std::min(dest.m_size, SuperCoder::symbol_size());
+
+            sak::const_storage src =
+                sak::storage(symbol(index), data_to_copy);
+
+            sak::copy_storage(dest, src);
+        }
+
+        /// @copydoc layer::symbols_available() const
+        uint32_t symbols_available() const
+        {
+            return SuperCoder::symbols();
+        }
+
+        /// @copydoc layer::symbols_initialized() const
+        uint32_t symbols_initialized() const
+        {
+            return m_symbols_count;
+        }
+
+        /// @copydoc layer::is_symbols_available() const
+        bool is_symbols_available() const
+        {
+            return true;
+        }
+
+        /// @copydoc layer::is_symbols_initialized() const
+        bool is_symbols_initialized() const
+        {
+            return m_symbols_count == SuperCoder::symbols();
+        }
+
+        /// @copydoc layer::is_symbol_available(uint32_t) const
+        bool is_symbol_available(uint32_t /*symbol_index*/) const
+        {
+            return true;
+        }
+
+        /// @copydoc layer::is_symbol_initialized(uint32_t) const
+        bool is_symbol_initialized(uint32_t symbol_index) const
+        {
+            return m_symbols[symbol_index];
+        }
+
+    private:
+
+        /// The storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
+            aligned_vector;
+
+        /// Storage for the augmented rows
+        aligned_vector m_data;
+
+        /// The offset in bytes of the symbol data within a row
+        uint32_t m_symbol_offset;
+
+        /// The number of bytes in a row which are updated by the
+        /// row operations
+        uint32_t m_augmented_size;
+
+        /// The distance in bytes between two rows
+        uint32_t m_stride;
+
+        /// Symbols count
+        uint32_t m_symbols_count;
+
+        /// Tracks which symbols have been set
+        std::vector<bool> m_symbols;
+
+    };
+
+    template<class SuperCoder>
+    const uint32_t augmented_symbol_storage<SuperCoder>::alignment;
+}
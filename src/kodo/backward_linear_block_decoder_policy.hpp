@@ -8,6 +8,8 @@
 #include <cstdint>
 #include <algorithm>
 
+#include "find_nonzero.hpp"
+
 namespace kodo
 {
 
@@ -61,6 +63,16 @@ namespace kodo
             return m_start - 1;
         }
 
+        /// Advance the policy to the next non-zero coefficient, if no
+        /// such coefficient exists the policy will be at the end
+        /// @param coefficients The coefficient vector
+        template<class Field>
+        void skip_zeros(const typename Field::value_type *coefficients)
+        {
+            uint32_t i = rfind_nonzero<Field>(coefficients, m_stop, m_start);
+            m_start = (i == m_start) ? m_stop : i + 1;
+        }
+
         /// @param a The first value
         /// @param b The second value
         /// @return the maximum value of the two input values
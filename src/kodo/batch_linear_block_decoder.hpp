@@ -0,0 +1,216 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "find_nonzero.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup codec_layers
+    /// @brief Decodes a batch of encoded symbols in one pass over the
+    ///        decoding matrix.
+    ///
+    /// When several encoded symbols are received back to back, decoding
+    /// them one at a time means that every stored pivot row is read
+    /// once per received symbol. This layer instead eliminates all
+    /// symbols in the batch against the pivot rows present when the
+    /// batch arrives, reading each of those rows only once. The
+    /// reduced symbols are then passed one by one to
+    /// layer::decode_symbol(uint8_t*,uint8_t*) which only has to
+    /// eliminate the pivots found within the batch itself.
+    ///
+    /// Like the innovation_check_decoder the pivots are first eliminated
+    /// from the coding coefficients only, while the coefficients used
+    /// are recorded. Symbols whose coefficients are reduced to zero are
+    /// dropped, and the recorded operations are only replayed on the
+    /// symbol data of the innovative symbols.
+    ///
+    /// The layer relies on the decoding matrix being kept in reduced
+    /// echelon form i.e. every pivot row has zeros in the columns of
+    /// all other pivots. This is the case for the Gauss-Jordan
+    /// decoders such as the forward_linear_block_decoder and the
+    /// backward_linear_block_decoder, but not for the
+    /// linear_block_decoder_delayed.
+    template<class SuperCoder>
+    class batch_linear_block_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+    public:
+
+        /// @copydoc layer::decode_symbols(uint8_t**,uint8_t**,uint32_t)
+        void decode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(SuperCoder::is_complete())
+            {
+                return;
+            }
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            m_values.assign(count * symbols, 0);
+
+            // Eliminate the current pivots from the coefficients of every
+            // symbol in the batch. Since the pivot rows are fully reduced
+            // the order in which they are visited does not matter.
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                if(!SuperCoder::symbol_pivot(i))
+                {
+                    continue;
+                }
+
+                reduce_coefficients(coefficients, count, i);
+            }
+
+            // Only the innovative symbols are reduced and decoded
+            m_innovative.resize(count);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                const value_type *vector_k =
+                    reinterpret_cast<const value_type*>(coefficients[k]);
+
+                m_innovative[k] =
+                    find_nonzero<field_type>(vector_k, 0, symbols) < symbols;
+            }
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                if(!SuperCoder::symbol_pivot(i))
+                {
+                    continue;
+                }
+
+                reduce_symbols(symbol_data, count, i);
+            }
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                if(!m_innovative[k])
+                {
+                    continue;
+                }
+
+                SuperCoder::decode_symbol(symbol_data[k], coefficients[k]);
+            }
+        }
+
+    protected:
+
+        /// Subtracts the coefficients of the pivot row at pivot_index
+        /// from every symbol in the batch which has a non-zero
+        /// coefficient at that position and records the coefficient
+        /// @param coefficients The coding coefficients of the batch
+        /// @param count The number of symbols in the batch
+        /// @param pivot_index The index of the pivot row
+        void reduce_coefficients(uint8_t **coefficients, uint32_t count,
+                                 uint32_t pivot_index)
+        {
+            const value_type *vector_i =
+                SuperCoder::coefficients_value(pivot_index);
+
+            uint32_t coefficients_length = SuperCoder::coefficients_length();
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                value_type *vector_k =
+                    reinterpret_cast<value_type*>(coefficients[k]);
+
+                value_type value =
+                    fifi::get_value<field_type>(vector_k, pivot_index);
+
+                if(!value)
+                {
+                    continue;
+                }
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(
+                        vector_k, vector_i, coefficients_length);
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(
+                        vector_k, vector_i, value, coefficients_length);
+                }
+
+                m_values[k * symbols + pivot_index] = value;
+            }
+        }
+
+        /// Replays the operations recorded for the pivot row at
+        /// pivot_index on the symbol data of the innovative symbols
+        /// @param symbol_data The symbol data of the batch
+        /// @param count The number of symbols in the batch
+        /// @param pivot_index The index of the pivot row
+        void reduce_symbols(uint8_t **symbol_data, uint32_t count,
+                            uint32_t pivot_index)
+        {
+            const value_type *symbol_i =
+                SuperCoder::symbol_value(pivot_index);
+
+            uint32_t symbol_length = SuperCoder::symbol_length();
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                value_type value = m_values[k * symbols + pivot_index];
+
+                if(!value || !m_innovative[k])
+                {
+                    continue;
+                }
+
+                value_type *symbol_k =
+                    reinterpret_cast<value_type*>(symbol_data[k]);
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(
+                        symbol_k, symbol_i, symbol_length);
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(
+                        symbol_k, symbol_i, value, symbol_length);
+                }
+            }
+        }
+
+    private:
+
+        /// The coefficients used for every symbol of the batch and every
+        /// pivot, zero where the pivot was not eliminated
+        std::vector<value_type> m_values;
+
+        /// Tracks which symbols of the batch are innovative
+        std::vector<bool> m_innovative;
+
+    };
+
+}
+
+
@@ -19,6 +19,7 @@
 
 #include <kodo/forward_linear_block_decoder_policy.hpp>
 #include <kodo/backward_linear_block_decoder_policy.hpp>
+#include <kodo/pivot_bitmap.hpp>
 
 namespace kodo
 {
@@ -59,8 +60,9 @@ namespace kodo
         {
             SuperCoder::construct(the_factory);
 
-            m_uncoded.resize(the_factory.max_symbols(), false);
-            m_coded.resize(the_factory.max_symbols(), false);
+            m_uncoded.resize(the_factory.max_symbols());
+            m_coded.resize(the_factory.max_symbols());
+            m_pivots.resize(the_factory.max_symbols());
         }
 
         /// @copydoc layer::initialize(Factory&)
@@ -69,8 +71,9 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            std::fill_n(m_uncoded.begin(), the_factory.symbols(), false);
-            std::fill_n(m_coded.begin(), the_factory.symbols(), false);
+            m_uncoded.reset(the_factory.symbols());
+            m_coded.reset(the_factory.symbols());
+            m_pivots.reset(the_factory.symbols());
 
             m_rank = 0;
 
@@ -131,7 +134,8 @@ namespace kodo
                 // backwards substitution
                 ++m_rank;
 
-                m_uncoded[ symbol_index ] = true;
+                m_uncoded.set(symbol_index);
+                m_pivots.set(symbol_index);
 
                 m_maximum_pivot =
                     direction_policy::max(symbol_index, m_maximum_pivot);
@@ -155,7 +159,13 @@ namespace kodo
         bool symbol_pivot(uint32_t index) const
         {
             assert(index < SuperCoder::symbols());
-            return m_coded[index] || m_uncoded[index];
+            return m_pivots[index];
+        }
+
+        /// @copydoc layer::symbol_pivots() const
+        const pivot_bitmap& symbol_pivots() const
+        {
+            return m_pivots;
         }
 
         /// @todo Add unit test
@@ -207,7 +217,8 @@ namespace kodo
             // We have increased the rank
             ++m_rank;
 
-            m_coded[ *pivot_index ] = true;
+            m_coded.set(*pivot_index);
+            m_pivots.set(*pivot_index);
 
             m_maximum_pivot =
                 direction_policy::max(*pivot_index, m_maximum_pivot);
@@ -225,7 +236,7 @@ namespace kodo
             assert(m_coded[pivot_index] == true);
             assert(m_uncoded[pivot_index] == false);
 
-            m_coded[pivot_index] = false;
+            m_coded.clear(pivot_index);
 
             value_type *symbol_i =
                 SuperCoder::symbol_value(pivot_index);
@@ -254,7 +265,7 @@ namespace kodo
             // Stores the symbol and sets the pivot in the vector
             store_uncoded_symbol(symbol_data, pivot_index);
 
-            m_uncoded[pivot_index] = true;
+            m_uncoded.set(pivot_index);
 
             // No need to backwards substitute since we are
             // replacing an existing symbol. I.e. backwards
@@ -315,6 +326,14 @@ namespace kodo
 
             for(direction_policy p(start, end); !p.at_end(); p.advance())
             {
+                // Jump straight to the next non-zero coefficient
+                p.template skip_zeros<field_type>(symbol_id);
+
+                if(p.at_end())
+                {
+                    break;
+                }
+
                 uint32_t i = p.index();
 
                 value_type current_coefficient
@@ -399,6 +418,14 @@ namespace kodo
 
             for(; !p.at_end(); p.advance())
             {
+                // Jump straight to the next non-zero coefficient
+                p.template skip_zeros<field_type>(symbol_id);
+
+                if(p.at_end())
+                {
+                    break;
+                }
+
                 uint32_t i = p.index();
 
                 // Do we have a non-zero value here?
@@ -458,68 +485,56 @@ namespace kodo
 
             assert(pivot_index < SuperCoder::symbols());
 
-            uint32_t from = direction_policy::min(0, SuperCoder::symbols()-1);
-            uint32_t to = m_maximum_pivot;
-
-            // std::cout << from << " " << to << std::endl;
-
             // We found a "1" that nobody else had as pivot, we now
             // substract this packet from other coded packets
-            // - if they have a "1" on our pivot place
-            for(direction_policy p(from, to); !p.at_end(); p.advance())
-            {
-                uint32_t i = p.index();
-
-                if( m_uncoded[i] )
-                {
-                    // We know that we have no non-zero elements
-                    // outside the pivot position.
-                    continue;
-                }
+            // - if they have a "1" on our pivot place. The uncoded
+            // symbols have no non-zero elements outside the pivot
+            // position so only the coded symbols are visited.
+            uint32_t symbols = SuperCoder::symbols();
 
+            for(uint32_t i = m_coded.find_next(0); i < symbols;
+                i = m_coded.find_next(i + 1))
+            {
                 if(i == pivot_index)
                 {
                     // We cannot backward substitute into ourself
                     continue;
                 }
 
-                if( m_coded[i] )
-                {
-                    value_type *vector_i =
-                        SuperCoder::coefficients_value(i);
+                value_type *vector_i =
+                    SuperCoder::coefficients_value(i);
 
-                    value_type value =
-                        fifi::get_value<field_type>(
-                            vector_i, pivot_index);
+                value_type value =
+                    fifi::get_value<field_type>(
+                        vector_i, pivot_index);
 
-                    if( value )
-                    {
+                if( value )
+                {
 
-                        value_type *symbol_i =
-                            SuperCoder::symbol_value(i);
+                    value_type *symbol_i =
+                        SuperCoder::symbol_value(i);
 
-                        if(fifi::is_binary<field_type>::value)
-                        {
-                            SuperCoder::subtract(
-                                vector_i, symbol_id,
-                                SuperCoder::coefficients_length());
+                    if(fifi::is_binary<field_type>::value)
+                    {
+                        SuperCoder::subtract(
+                            vector_i, symbol_id,
+                            SuperCoder::coefficients_length());
 
-                            SuperCoder::subtract(
-                                symbol_i, symbol_data,
-                                SuperCoder::symbol_length());
-                        }
-                        else
-                        {
+                        SuperCoder::subtract(
+                            symbol_i, symbol_data,
+                            SuperCoder::symbol_length());
+                    }
+                    else
+                    {
 
-                            // Update symbol and corresponding vector
-                            SuperCoder::multiply_subtract(
-                                vector_i, symbol_id, value,
-                                SuperCoder::coefficients_length());
+                        // Update symbol and corresponding vector
+                        SuperCoder::multiply_subtract(
+                            vector_i, symbol_id, value,
+                            SuperCoder::coefficients_length());
 
-                            SuperCoder::multiply_subtract(
-                                symbol_i, symbol_data, value,
-                                SuperCoder::symbol_length());
-                        }
+                        SuperCoder::multiply_subtract(
+                            symbol_i, symbol_data, value,
+                            SuperCoder::symbol_length());
                     }
                 }
             }
@@ -601,10 +616,14 @@ namespace kodo
 
         /// Tracks whether a symbol is contained which
         /// is fully decoded
-        std::vector<bool> m_uncoded;
+        pivot_bitmap m_uncoded;
 
         /// Tracks whether a symbol is partially decoded
-        std::vector<bool> m_coded;
+        pivot_bitmap m_coded;
+
+        /// Tracks the pivots i.e. the symbols which are either
+        /// partially or fully decoded
+        pivot_bitmap m_pivots;
     };
 
 }
@@ -0,0 +1,63 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace kodo
+{
+
+    /// @param value A non-zero word
+    /// @return The index of the least significant set bit in the word
+    inline uint32_t count_trailing_zeros(uint64_t value)
+    {
+        assert(value != 0);
+
+#if defined(__GNUC__)
+        return __builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return index;
+#else
+        uint32_t index = 0;
+        while((value & 0x1) == 0)
+        {
+            value >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    /// @param value A non-zero word
+    /// @return The index of the most significant set bit in the word
+    inline uint32_t most_significant_bit(uint64_t value)
+    {
+        assert(value != 0);
+
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        uint32_t index = 0;
+        while(value >>= 1)
+        {
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+}
@@ -0,0 +1,313 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+namespace kodo
+{
+
+    /// @brief Resource pool which can be filled in advance and which
+    ///        limits the number of unused resources it keeps.
+    ///
+    /// The interface follows the sak::resource_pool, allocate() returns
+    /// a resource which is recycled into the pool when the last
+    /// reference to it is released. Resources released while the pool
+    /// already holds max_pooled() unused resources are deleted. The
+    /// pool is not thread-safe, see the concurrent_resource_pool.
+    template<class Value>
+    class bounded_resource_pool
+    {
+    public:
+
+        /// Pointer to a resource
+        typedef boost::shared_ptr<Value> value_ptr;
+
+        /// The function creating new resources
+        typedef boost::function<value_ptr ()> allocator_function;
+
+    public:
+
+        /// Constructor
+        /// @param allocator The function creating new resources
+        explicit bounded_resource_pool(allocator_function allocator)
+            : m_pool(boost::make_shared<impl>(allocator))
+        { }
+
+        /// @return A resource from the pool, a new resource is created if
+        ///         no unused resources are available
+        value_ptr allocate()
+        {
+            return m_pool->allocate(m_pool);
+        }
+
+        /// Creates resources until the pool holds at least the given
+        /// number of unused resources or max_pooled() is reached
+        /// @param resources The number of unused resources wanted
+        void reserve(uint32_t resources)
+        {
+            m_pool->reserve(resources);
+        }
+
+        /// Sets the maximum number of unused resources kept, unused
+        /// resources above the limit are deleted
+        /// @param resources The maximum number of unused resources
+        void set_max_pooled(uint32_t resources)
+        {
+            m_pool->set_max_pooled(resources);
+        }
+
+        /// @return The maximum number of unused resources kept
+        uint32_t max_pooled() const
+        {
+            return m_pool->m_max_pooled;
+        }
+
+        /// @return The number of resources created by the pool and not
+        ///         yet deleted
+        uint32_t total_resources() const
+        {
+            return m_pool->m_total;
+        }
+
+        /// @return The number of resources currently in the pool
+        uint32_t unused_resources() const
+        {
+            return static_cast<uint32_t>(m_pool->m_free.size());
+        }
+
+        /// @return The number of resources handed out and not yet
+        ///         released
+        uint32_t used_resources() const
+        {
+            return m_pool->m_used;
+        }
+
+        /// @return The highest number of resources in use at the same
+        ///         time
+        uint32_t used_high_water_mark() const
+        {
+            return m_pool->m_used_high_water;
+        }
+
+        /// @return The highest number of resources owned by the pool at
+        ///         the same time
+        uint32_t total_high_water_mark() const
+        {
+            return m_pool->m_total_high_water;
+        }
+
+        /// @return The number of resources created
+        uint64_t created_resources() const
+        {
+            return m_pool->m_created;
+        }
+
+        /// @return The number of allocations served from the pool
+        uint64_t recycled_resources() const
+        {
+            return m_pool->m_recycled;
+        }
+
+        /// Deletes the resources currently in the pool
+        void free_unused_resources()
+        {
+            m_pool->trim(0);
+        }
+
+    private:
+
+        /// Shared state of the pool which the released resources
+        /// reference weakly
+        class impl : boost::noncopyable
+        {
+        public:
+
+            /// Constructor
+            /// @param allocator The function creating new resources
+            impl(allocator_function allocator)
+                : m_allocator(allocator),
+                  m_max_pooled(std::numeric_limits<uint32_t>::max()),
+                  m_total(0),
+                  m_used(0),
+                  m_used_high_water(0),
+                  m_total_high_water(0),
+                  m_created(0),
+                  m_recycled(0)
+            { }
+
+            /// @copydoc bounded_resource_pool::allocate()
+            /// @param self Pointer to this pool referenced by the deleter
+            value_ptr allocate(const boost::shared_ptr<impl> &self)
+            {
+                value_ptr resource;
+
+                if(m_free.empty())
+                {
+                    resource = create();
+                }
+                else
+                {
+                    resource = m_free.back();
+                    m_free.pop_back();
+
+                    ++m_recycled;
+                }
+
+                ++m_used;
+                m_used_high_water = std::max(m_used_high_water, m_used);
+
+                return value_ptr(resource.get(), deleter(self, resource));
+            }
+
+            /// @copydoc bounded_resource_pool::reserve(uint32_t)
+            void reserve(uint32_t resources)
+            {
+                resources = std::min(resources, m_max_pooled);
+
+                while(m_free.size() < resources)
+                {
+                    m_free.push_back(create());
+                }
+            }
+
+            /// @copydoc bounded_resource_pool::set_max_pooled(uint32_t)
+            void set_max_pooled(uint32_t resources)
+            {
+                m_max_pooled = resources;
+                trim(m_max_pooled);
+            }
+
+            /// Deletes unused resources down to the given number
+            /// @param resources The number of unused resources to keep
+            void trim(uint32_t resources)
+            {
+                while(m_free.size() > resources)
+                {
+                    m_free.pop_back();
+                    --m_total;
+                }
+            }
+
+            /// Returns a released resource to the pool or deletes it if
+            /// the pool is full
+            /// @param resource The resource
+            void recycle(const value_ptr &resource)
+            {
+                assert(m_used > 0);
+                --m_used;
+
+                if(m_free.size() < m_max_pooled)
+                {
+                    m_free.push_back(resource);
+                }
+                else
+                {
+                    --m_total;
+                }
+            }
+
+        private:
+
+            /// @return A new resource
+            value_ptr create()
+            {
+                value_ptr resource = m_allocator();
+                assert(resource);
+
+                ++m_created;
+                ++m_total;
+
+                m_total_high_water = std::max(m_total_high_water, m_total);
+
+                return resource;
+            }
+
+        public:
+
+            /// The function creating new resources
+            allocator_function m_allocator;
+
+            /// The unused resources
+            std::vector<value_ptr> m_free;
+
+            /// The maximum number of unused resources kept
+            uint32_t m_max_pooled;
+
+            /// The number of resources owned by the pool
+            uint32_t m_total;
+
+            /// The number of resources in use
+            uint32_t m_used;
+
+            /// The highest number of resources in use
+            uint32_t m_used_high_water;
+
+            /// The highest number of resources owned by the pool
+            uint32_t m_total_high_water;
+
+            /// The number of resources created
+            uint64_t m_created;
+
+            /// The number of allocations served from the pool
+            uint64_t m_recycled;
+
+        };
+
+        /// Deleter of the handed out resources, which returns the
+        /// resource to the pool if the pool still exists
+        class deleter
+        {
+        public:
+
+            /// Constructor
+            /// @param pool The pool of the resource
+            /// @param resource The resource
+            deleter(const boost::weak_ptr<impl> &pool,
+                    const value_ptr &resource)
+                : m_pool(pool),
+                  m_resource(resource)
+            { }
+
+            /// Recycles the resource
+            void operator()(Value*)
+            {
+                if(boost::shared_ptr<impl> pool = m_pool.lock())
+                {
+                    pool->recycle(m_resource);
+                }
+
+                m_resource.reset();
+            }
+
+        private:
+
+            /// The pool of the resource
+            boost::weak_ptr<impl> m_pool;
+
+            /// The resource
+            value_ptr m_resource;
+
+        };
+
+    private:
+
+        /// The shared state of the pool
+        boost::shared_ptr<impl> m_pool;
+
+    };
+
+}
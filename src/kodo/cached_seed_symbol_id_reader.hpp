@@ -0,0 +1,155 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <sak/convert_endian.hpp>
+
+#include "seed_coefficient_cache.hpp"
+#include "seed_symbol_id_reader.hpp"
+
+namespace kodo
+{
+
+    /// @brief Seed symbol id reader which keeps the most recently
+    ///        regenerated coefficient vectors in a seed_coefficient_cache.
+    ///
+    /// The coefficients produced from a seed only depend on the seed,
+    /// the number of symbols and the field, so symbols received more
+    /// than once reuse the cached vector instead of running the
+    /// generator again. The cache is owned by the factory and shared
+    /// by all decoders it builds.
+    ///
+    /// @ingroup symbol_id_layers
+    template<class SuperCoder>
+    class cached_seed_symbol_id_reader
+        : public seed_symbol_id_reader<SuperCoder>
+    {
+    public:
+
+        /// The seed symbol id reader
+        typedef seed_symbol_id_reader<SuperCoder> Super;
+
+        /// The seed type from the generator used
+        typedef typename Super::seed_type seed_type;
+
+        /// Pointer to the cache of coefficient vectors
+        typedef boost::shared_ptr<seed_coefficient_cache> cache_pointer;
+
+        /// The seed and the number of symbols must fit in the key
+        static_assert(sizeof(seed_type) <= sizeof(uint32_t),
+                      "Seed must fit in the low half of the cache key");
+
+        /// The default maximum number of cached vectors
+        static const uint32_t default_cache_capacity = 64;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder. Holds the cache
+        /// shared by the built decoders.
+        class factory : public Super::factory
+        {
+        public:
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size)
+                : Super::factory(max_symbols, max_symbol_size)
+            {
+                m_seed_cache = boost::make_shared<seed_coefficient_cache>(
+                    default_cache_capacity);
+            }
+
+            /// @return The cache used by the decoders built
+            cache_pointer seed_cache() const
+            {
+                return m_seed_cache;
+            }
+
+            /// Sets the cache used by the decoders built from now on,
+            /// which allows several factories to share a cache
+            /// @param cache The cache, must not be empty
+            void set_seed_cache(const cache_pointer &cache)
+            {
+                assert(cache);
+                m_seed_cache = cache;
+            }
+
+        protected:
+
+            /// The cache shared by the built decoders
+            cache_pointer m_seed_cache;
+
+        };
+
+    public:
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            Super::initialize(the_factory);
+
+            m_seed_cache = the_factory.seed_cache();
+            assert(m_seed_cache);
+        }
+
+        /// @copydoc layer::read_id(uint8_t*, uint8_t**)
+        void read_id(uint8_t *symbol_id, uint8_t **symbol_coefficients)
+        {
+            assert(symbol_id != 0);
+            assert(symbol_coefficients != 0);
+
+            seed_type seed = sak::big_endian::get<seed_type>(symbol_id);
+
+            if(!Super::has_seed_version(seed))
+            {
+                Super::read_id(symbol_id, symbol_coefficients);
+                return;
+            }
+
+            seed_coefficient_cache::key_type key =
+                (seed_coefficient_cache::key_type(Super::symbols()) << 32) |
+                seed;
+
+            uint32_t size = Super::coefficients_size();
+
+            if(m_seed_cache->find(key, &m_coefficients[0], size))
+            {
+                *symbol_coefficients = &m_coefficients[0];
+                return;
+            }
+
+            Super::read_id(symbol_id, symbol_coefficients);
+            m_seed_cache->insert(key, *symbol_coefficients, size);
+        }
+
+        /// @return The cache used by this decoder
+        cache_pointer seed_cache() const
+        {
+            return m_seed_cache;
+        }
+
+    protected:
+
+        /// The coefficient buffer of the seed symbol id reader
+        using Super::m_coefficients;
+
+        /// The cache shared with the other decoders of the factory
+        cache_pointer m_seed_cache;
+
+    };
+
+    template<class SuperCoder>
+    const uint32_t
+    cached_seed_symbol_id_reader<SuperCoder>::default_cache_capacity;
+
+}
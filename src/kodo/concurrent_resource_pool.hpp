@@ -0,0 +1,595 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <thread>
+
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+namespace kodo
+{
+
+    /// @brief Resource pool which may be used from several threads at
+    ///        the same time.
+    ///
+    /// The interface follows the sak::resource_pool, allocate() returns
+    /// a resource which is recycled into the pool when the last
+    /// reference to it is released. The unused resources are kept in a
+    /// number of lock-free free lists, each thread prefers the free
+    /// list selected by its thread id and only takes resources from the
+    /// other lists when its own is empty. Threads which allocate and
+    /// release their own resources therefore rarely touch the same
+    /// memory.
+    ///
+    /// The free lists link nodes by index rather than by pointer and
+    /// tag the list heads with a counter to avoid the ABA problem. The
+    /// nodes are kept until the pool is destroyed, resources which are
+    /// still in use at that point are deleted when they are released.
+    template<class Value>
+    class concurrent_resource_pool
+    {
+    public:
+
+        /// Pointer to a resource
+        typedef boost::shared_ptr<Value> value_ptr;
+
+        /// The function creating new resources
+        typedef boost::function<value_ptr ()> allocator_function;
+
+    public:
+
+        /// Constructor
+        /// @param allocator The function creating new resources
+        /// @param caches The number of free lists, zero selects one per
+        ///        hardware thread
+        explicit concurrent_resource_pool(allocator_function allocator,
+                                          uint32_t caches = 0)
+        {
+            if(caches == 0)
+            {
+                caches = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+
+            m_pool = boost::make_shared<impl>(allocator, caches);
+        }
+
+        /// @return A resource from the pool, a new resource is created if
+        ///         no unused resources are available
+        value_ptr allocate()
+        {
+            return m_pool->allocate(m_pool);
+        }
+
+        /// @return The number of resources created by the pool and not
+        ///         yet freed
+        uint32_t total_resources() const
+        {
+            return m_pool->m_total.load();
+        }
+
+        /// @return The number of resources currently in the pool
+        uint32_t unused_resources() const
+        {
+            return m_pool->m_unused.load();
+        }
+
+        /// @return The number of resources handed out and not yet
+        ///         released
+        uint32_t used_resources() const
+        {
+            return m_pool->m_used.load();
+        }
+
+        /// @return The highest number of resources in use at the same
+        ///         time
+        uint32_t used_high_water_mark() const
+        {
+            return m_pool->m_used_high_water.load();
+        }
+
+        /// @return The highest number of resources owned by the pool at
+        ///         the same time
+        uint32_t total_high_water_mark() const
+        {
+            return m_pool->m_total_high_water.load();
+        }
+
+        /// @return The number of resources created
+        uint64_t created_resources() const
+        {
+            return m_pool->m_created.load();
+        }
+
+        /// @return The number of allocations served from the pool
+        uint64_t recycled_resources() const
+        {
+            return m_pool->m_recycled.load();
+        }
+
+        /// @return The number of free lists
+        uint32_t caches() const
+        {
+            return m_pool->m_caches;
+        }
+
+        /// Creates resources until the pool holds at least the given
+        /// number of unused resources or max_pooled() is reached. The
+        /// resources are added to the free list of the calling thread.
+        /// @param resources The number of unused resources wanted
+        void reserve(uint32_t resources)
+        {
+            m_pool->reserve(resources);
+        }
+
+        /// Sets the maximum number of unused resources kept, unused
+        /// resources above the limit are deleted
+        /// @param resources The maximum number of unused resources
+        void set_max_pooled(uint32_t resources)
+        {
+            m_pool->m_max_pooled.store(resources);
+            m_pool->trim(resources);
+        }
+
+        /// @return The maximum number of unused resources kept
+        uint32_t max_pooled() const
+        {
+            return m_pool->m_max_pooled.load();
+        }
+
+        /// Frees the resources currently in the pool
+        void free_unused_resources()
+        {
+            m_pool->trim(0);
+        }
+
+    private:
+
+        /// Shared state of the pool which the released resources
+        /// reference weakly
+        class impl : boost::noncopyable
+        {
+        public:
+
+            /// Value of an empty free list and the end of a list
+            static const uint32_t null_index = 0;
+
+            /// Number of node segments, segment k holds 2^k nodes
+            static const uint32_t segment_count = 32;
+
+            /// A resource slot
+            struct node
+            {
+                /// The resource while it is in the pool
+                value_ptr m_value;
+
+                /// The index of the next node in the free list
+                std::atomic<uint32_t> m_next;
+            };
+
+            /// The head of a free list, padded to a cache line to avoid
+            /// false sharing between the lists
+            struct free_list
+            {
+                /// The tag in the high and the node index in the low
+                /// 32 bits
+                std::atomic<uint64_t> m_head;
+
+                /// Padding to the size of a cache line
+                uint8_t m_padding[64 - sizeof(std::atomic<uint64_t>)];
+            };
+
+        public:
+
+            /// Constructor
+            /// @param allocator The function creating new resources
+            /// @param caches The number of free lists
+            impl(allocator_function allocator, uint32_t caches)
+                : m_allocator(allocator),
+                  m_caches(caches),
+                  m_free(new free_list[caches]),
+                  m_nodes(0),
+                  m_total(0),
+                  m_unused(0),
+                  m_used(0),
+                  m_used_high_water(0),
+                  m_total_high_water(0),
+                  m_max_pooled(std::numeric_limits<uint32_t>::max()),
+                  m_created(0),
+                  m_recycled(0)
+            {
+                assert(m_caches > 0);
+
+                for(uint32_t i = 0; i < m_caches; ++i)
+                {
+                    m_free[i].m_head.store(0);
+                }
+
+                m_spare.m_head.store(0);
+
+                for(uint32_t i = 0; i < segment_count; ++i)
+                {
+                    m_segments[i].store(0);
+                }
+            }
+
+            /// Destructor
+            ~impl()
+            {
+                delete [] m_free;
+
+                for(uint32_t i = 0; i < segment_count; ++i)
+                {
+                    delete [] m_segments[i].load();
+                }
+            }
+
+            /// @copydoc concurrent_resource_pool::allocate()
+            /// @param self Pointer to this pool referenced by the deleter
+            value_ptr allocate(const boost::shared_ptr<impl> &self)
+            {
+                uint32_t cache = this_cache();
+                uint32_t index = null_index;
+
+                for(uint32_t i = 0; i < m_caches; ++i)
+                {
+                    index = pop(m_free[(cache + i) % m_caches]);
+
+                    if(index != null_index)
+                    {
+                        break;
+                    }
+                }
+
+                if(index != null_index)
+                {
+                    --m_unused;
+                    ++m_recycled;
+                }
+                else
+                {
+                    index = create();
+                }
+
+                value_ptr resource;
+                resource.swap(at(index).m_value);
+                assert(resource);
+
+                update_high_water(m_used_high_water, ++m_used);
+
+                return value_ptr(resource.get(),
+                                 deleter(self, resource, index));
+            }
+
+            /// @copydoc concurrent_resource_pool::reserve(uint32_t)
+            void reserve(uint32_t resources)
+            {
+                resources = std::min(resources, m_max_pooled.load());
+
+                while(m_unused.load() < resources)
+                {
+                    uint32_t index = create();
+
+                    ++m_unused;
+                    push(m_free[this_cache()], index);
+                }
+            }
+
+            /// Deletes unused resources down to the given number
+            /// @param resources The number of unused resources to keep
+            void trim(uint32_t resources)
+            {
+                for(uint32_t i = 0; i < m_caches; ++i)
+                {
+                    while(m_unused.load() > resources)
+                    {
+                        uint32_t index = pop(m_free[i]);
+
+                        if(index == null_index)
+                        {
+                            break;
+                        }
+
+                        --m_unused;
+                        destroy(index);
+                    }
+                }
+            }
+
+            /// Returns a released resource to the free list of the
+            /// calling thread
+            /// @param resource The resource
+            /// @param index The node of the resource
+            void recycle(const value_ptr &resource, uint32_t index)
+            {
+                --m_used;
+
+                // The limit may be exceeded briefly by concurrent releases
+                if(m_unused.load() >= m_max_pooled.load())
+                {
+                    push(m_spare, index);
+                    --m_total;
+                    return;
+                }
+
+                at(index).m_value = resource;
+
+                ++m_unused;
+                push(m_free[this_cache()], index);
+            }
+
+        private:
+
+            /// Creates a resource and stores it in a node
+            /// @return The node holding the resource
+            uint32_t create()
+            {
+                value_ptr resource = m_allocator();
+                assert(resource);
+
+                uint32_t index = pop(m_spare);
+
+                if(index == null_index)
+                {
+                    index = new_node();
+                }
+
+                at(index).m_value = resource;
+
+                ++m_created;
+                update_high_water(m_total_high_water, ++m_total);
+
+                return index;
+            }
+
+            /// Deletes the resource of a node taken from a free list
+            /// @param index The node
+            void destroy(uint32_t index)
+            {
+                at(index).m_value.reset();
+                push(m_spare, index);
+
+                --m_total;
+            }
+
+            /// @return The free list preferred by the calling thread
+            uint32_t this_cache() const
+            {
+                std::size_t hash =
+                    std::hash<std::thread::id>()(std::this_thread::get_id());
+
+                return static_cast<uint32_t>(hash % m_caches);
+            }
+
+            /// @param index The index of a node
+            /// @return The node
+            node& at(uint32_t index)
+            {
+                assert(index != null_index);
+
+                uint32_t segment = 31 - leading_zeros(index);
+                uint32_t offset = index - (1U << segment);
+
+                node *nodes = m_segments[segment].load();
+                assert(nodes != 0);
+
+                return nodes[offset];
+            }
+
+            /// @return The index of a node not used before
+            uint32_t new_node()
+            {
+                // Indices start at one to keep zero as the null index
+                uint32_t index = ++m_nodes;
+                assert(index != null_index);
+
+                uint32_t segment = 31 - leading_zeros(index);
+
+                if(m_segments[segment].load() == 0)
+                {
+                    node *nodes = new node[1U << segment];
+                    node *expected = 0;
+
+                    if(!m_segments[segment].compare_exchange_strong(
+                           expected, nodes))
+                    {
+                        // Another thread allocated the segment
+                        delete [] nodes;
+                    }
+                }
+
+                return index;
+            }
+
+            /// @param list The free list
+            /// @param index The node to push on the list
+            void push(free_list &list, uint32_t index)
+            {
+                node &n = at(index);
+                uint64_t head = list.m_head.load();
+
+                for(;;)
+                {
+                    n.m_next.store(static_cast<uint32_t>(head));
+
+                    uint64_t tag = (head >> 32) + 1;
+                    uint64_t next = (tag << 32) | index;
+
+                    if(list.m_head.compare_exchange_weak(head, next))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            /// @param list The free list
+            /// @return The node popped from the list or the null index if
+            ///         the list was empty
+            uint32_t pop(free_list &list)
+            {
+                uint64_t head = list.m_head.load();
+
+                for(;;)
+                {
+                    uint32_t index = static_cast<uint32_t>(head);
+
+                    if(index == null_index)
+                    {
+                        return null_index;
+                    }
+
+                    // The node may be popped by another thread meanwhile,
+                    // the tag makes the exchange fail in that case
+                    uint64_t tag = (head >> 32) + 1;
+                    uint64_t next = (tag << 32) | at(index).m_next.load();
+
+                    if(list.m_head.compare_exchange_weak(head, next))
+                    {
+                        return index;
+                    }
+                }
+            }
+
+            /// @param value A non-zero value
+            /// @return The number of leading zero bits
+            static uint32_t leading_zeros(uint32_t value)
+            {
+                assert(value != 0);
+
+                uint32_t zeros = 0;
+
+                while((value & 0x80000000U) == 0)
+                {
+                    value <<= 1;
+                    ++zeros;
+                }
+
+                return zeros;
+            }
+
+            /// Raises a high-water mark to the given value
+            /// @param mark The high-water mark
+            /// @param value The current value
+            static void update_high_water(std::atomic<uint32_t> &mark,
+                                          uint32_t value)
+            {
+                uint32_t current = mark.load();
+
+                while(current < value &&
+                      !mark.compare_exchange_weak(current, value))
+                { }
+            }
+
+        public:
+
+            /// The function creating new resources
+            allocator_function m_allocator;
+
+            /// The number of free lists
+            const uint32_t m_caches;
+
+            /// The free lists of unused resources
+            free_list *m_free;
+
+            /// The list of nodes without a resource
+            free_list m_spare;
+
+            /// The node segments
+            std::atomic<node*> m_segments[segment_count];
+
+            /// The number of nodes handed out
+            std::atomic<uint32_t> m_nodes;
+
+            /// The number of resources owned by the pool
+            std::atomic<uint32_t> m_total;
+
+            /// The number of resources in the free lists
+            std::atomic<uint32_t> m_unused;
+
+            /// The number of resources in use
+            std::atomic<uint32_t> m_used;
+
+            /// The highest number of resources in use
+            std::atomic<uint32_t> m_used_high_water;
+
+            /// The highest number of resources owned by the pool
+            std::atomic<uint32_t> m_total_high_water;
+
+            /// The maximum number of unused resources kept
+            std::atomic<uint32_t> m_max_pooled;
+
+            /// The number of resources created
+            std::atomic<uint64_t> m_created;
+
+            /// The number of allocations served from the pool
+            std::atomic<uint64_t> m_recycled;
+
+        };
+
+        /// Deleter of the handed out resources, which returns the
+        /// resource to the pool if the pool still exists
+        class deleter
+        {
+        public:
+
+            /// Constructor
+            /// @param pool The pool of the resource
+            /// @param resource The resource
+            /// @param index The node of the resource
+            deleter(const boost::weak_ptr<impl> &pool,
+                    const value_ptr &resource, uint32_t index)
+                : m_pool(pool),
+                  m_resource(resource),
+                  m_index(index)
+            { }
+
+            /// Recycles the resource
+            void operator()(Value*)
+            {
+                if(boost::shared_ptr<impl> pool = m_pool.lock())
+                {
+                    pool->recycle(m_resource, m_index);
+                }
+
+                m_resource.reset();
+            }
+
+        private:
+
+            /// The pool of the resource
+            boost::weak_ptr<impl> m_pool;
+
+            /// The resource
+            value_ptr m_resource;
+
+            /// The node of the resource
+            uint32_t m_index;
+
+        };
+
+    private:
+
+        /// The shared state of the pool
+        boost::shared_ptr<impl> m_pool;
+
+    };
+
+    template<class Value>
+    const uint32_t concurrent_resource_pool<Value>::impl::null_index;
+
+    template<class Value>
+    const uint32_t concurrent_resource_pool<Value>::impl::segment_count;
+
+}
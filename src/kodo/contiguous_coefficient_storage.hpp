@@ -0,0 +1,150 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/fifi_utils.hpp>
+
+#include <sak/storage.hpp>
+#include <sak/aligned_allocator.hpp>
+
+#include "padded_size.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_storage_layers
+    /// @brief Provides storage and access to the coding coefficients
+    ///        used during encoding and decoding. All coefficient
+    ///        vectors are stored in a single aligned memory block.
+    ///
+    /// The layer is a drop-in replacement for the coefficient_storage
+    /// layer. Instead of allocating every coefficient vector
+    /// separately the entire coefficient matrix is stored in one
+    /// buffer using a row stride which is padded to a multiple of the
+    /// alignment. This keeps every coefficient vector aligned (which
+    /// is needed when using SSE etc. instructions) while placing the
+    /// rows next to each other in memory, which makes the row
+    /// operations performed by the decoder much more cache friendly.
+    template<class SuperCoder>
+    class contiguous_coefficient_storage : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+        /// The alignment in bytes of every coefficient vector
+        static const uint32_t alignment = buffer_alignment;
+
+    public:
+
+        /// Constructor
+        contiguous_coefficient_storage()
+            : m_stride(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            uint32_t max_stride =
+                padded_size(the_factory.max_coefficients_size());
+
+            m_coefficients_storage.resize(
+                the_factory.max_symbols() * max_stride, 0);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            // We use the stride of the current coefficients size,
+            // this packs the rows as tightly as possible also when
+            // the number of symbols is less than the maximum.
+            m_stride = padded_size(SuperCoder::coefficients_size());
+
+            assert(SuperCoder::symbols() * m_stride <=
+                   m_coefficients_storage.size());
+        }
+
+        /// @copydoc layer::coefficients(uint32_t)
+        uint8_t* coefficients(uint32_t index)
+        {
+            assert(index < SuperCoder::symbols());
+            return &m_coefficients_storage[index * m_stride];
+        }
+
+        /// @copydoc layer::coefficients(uint32_t) const
+        const uint8_t* coefficients(uint32_t index) const
+        {
+            assert(index < SuperCoder::symbols());
+            return &m_coefficients_storage[index * m_stride];
+        }
+
+        /// @copydoc layer::coefficients_value(uint32_t)
+        value_type* coefficients_value(uint32_t index)
+        {
+            return reinterpret_cast<value_type*>(
+                coefficients(index));
+        }
+
+        /// @copydoc layer::coefficients_value(uint32_t) const
+        const value_type* coefficients_value(uint32_t index) const
+        {
+            return reinterpret_cast<const value_type*>(
+                coefficients(index));
+        }
+
+        /// @copydoc layer::set_coefficients(
+        ///              uint32_t,const sak::const_storage&)
+        void set_coefficients(uint32_t index,
+                              const sak::const_storage &storage)
+        {
+            assert(storage.m_size == SuperCoder::coefficients_size());
+            assert(storage.m_data != 0);
+
+            auto dest = sak::storage(
+                coefficients(index), SuperCoder::coefficients_size());
+
+            sak::copy_storage(dest, storage);
+        }
+
+        /// @return The distance in bytes between two consecutive
+        ///         coefficient vectors
+        uint32_t coefficients_stride() const
+        {
+            return m_stride;
+        }
+
+    private:
+
+        /// The storage type - using the aligned allocator ensures
+        /// that the first row is aligned, the padded stride ensures
+        /// that all remaining rows are aligned as well
+        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
+            aligned_vector;
+
+        /// Stores the entire coefficient matrix
+        aligned_vector m_coefficients_storage;
+
+        /// The distance in bytes between two coefficient vectors
+        uint32_t m_stride;
+
+    };
+
+    template<class SuperCoder>
+    const uint32_t contiguous_coefficient_storage<SuperCoder>::alignment;
+}
@@ -59,7 +59,7 @@ namespace kodo
         /// @param object_size The size of the object to be decoded in bytes
         /// @param decoding_buffer The storage where the object will be
         ///        decoded
-        deep_storage_decoder(factory &factory, uint32_t object_size) :
+        deep_storage_decoder(factory &factory, uint64_t object_size) :
             base_decoder(factory, object_size)
         {
             // Resize the decoding storage buffer to be large enough
@@ -72,19 +72,15 @@ namespace kodo
         {
             auto decoder = base_decoder::build(decoder_id);
 
-            uint32_t offset = m_partitioning.byte_offset(decoder_id);
+            uint64_t offset = m_partitioning.byte_offset(decoder_id);
             uint32_t block_size = m_partitioning.block_size(decoder_id);
 
-            sak::mutable_storage data = sak::storage(m_decoding_storage);
-            data += offset;
+            assert(offset + block_size <= m_decoding_storage.size());
 
-            assert(data.m_size >= block_size);
-
-            // Adjust the size of the decoding buffer to fit this
-            // decoder
-            data.m_size = block_size;
-
-            decoder->set_symbols(data);
+            // Index the buffer with the 64 bit offset, only the block
+            // itself is wrapped in a storage object
+            decoder->set_symbols(
+                sak::storage(&m_decoding_storage[offset], block_size));
 
             return decoder;
         }
@@ -59,8 +59,12 @@ namespace kodo
             /// @todo This should not be necessary - we should not
             ///       use data which has not been initialized yet
             ///       anyway
-            std::fill(m_data.begin(), m_data.end(), 0);
-            std::fill(m_symbols.begin(), m_symbols.end(), false);
+            ///
+            /// Only the symbols of the current block are cleared, the
+            /// buffer is sized for the largest block the factory
+            /// supports and the rest of it is never accessed.
+            std::fill_n(m_data.begin(), SuperCoder::block_size(), 0);
+            std::fill_n(m_symbols.begin(), SuperCoder::symbols(), false);
 
             m_symbols_count = 0;
         }
@@ -44,6 +44,24 @@ namespace kodo
             ++m_counter;
         }
 
+        /// @copydoc layer::encode_sparse_symbol(uint8_t*, uint8_t*,
+        ///                                      const uint32_t*, uint32_t)
+        void encode_sparse_symbol(uint8_t *symbol_data, uint8_t *coefficients,
+                                  const uint32_t *positions, uint32_t count)
+        {
+            SuperCoder::encode_sparse_symbol(
+                symbol_data, coefficients, positions, count);
+            ++m_counter;
+        }
+
+        /// @copydoc layer::encode_symbols(uint8_t**,uint8_t**,uint32_t)
+        void encode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            SuperCoder::encode_symbols(symbol_data, coefficients, count);
+            m_counter += count;
+        }
+
         /// @return the symbol encoded counter
         uint32_t encode_symbol_count() const
         {
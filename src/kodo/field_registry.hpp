@@ -0,0 +1,42 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace kodo
+{
+
+    /// @ingroup finite_field_layers
+    /// @brief Process wide registry of finite field implementations.
+    ///
+    /// The lookup tables of a field implementation do not change after
+    /// it has been constructed, so a single instance is shared by all
+    /// factories using the same implementation. The instance is built
+    /// on first use, which is safe from several threads.
+    template<class FieldImpl>
+    class field_registry
+    {
+    public:
+
+        /// Pointer to the finite field implementation
+        typedef boost::shared_ptr<FieldImpl> field_pointer;
+
+    public:
+
+        /// @return The shared instance of the field implementation
+        static field_pointer get()
+        {
+            static const field_pointer field =
+                boost::make_shared<FieldImpl>();
+
+            return field;
+        }
+
+    };
+
+}
@@ -0,0 +1,344 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "posix_file_api.hpp"
+
+#if !defined(KODO_POSIX_FILE_API)
+    #error "The file_decoder requires the POSIX file API"
+#endif
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "object_decoder.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+
+    /// @brief A file decoder decodes an object directly into a local
+    ///        file.
+    ///
+    /// Only the decoders of the blocks currently being decoded are kept
+    /// in memory. As soon as a decoder is complete its block is written
+    /// to the file at the byte offset of the block and the decoder is
+    /// released, which returns it to the pool of the factory. Decoding a
+    /// large object therefore only needs memory for the blocks in
+    /// flight rather than for the entire object.
+    ///
+    /// The decoded symbols are written with pwritev() directly from the
+    /// symbol storage of the decoder. The writes are synchronous, since
+    /// releasing a decoder from another thread would access the factory
+    /// pool concurrently.
+    ///
+    /// The decoder uses the POSIX file API, see posix_file_api.hpp.
+    /// File errors are reported by throwing std::system_error. A block
+    /// which fails to be written is kept in flight, so writing it can
+    /// be retried with write_if_complete().
+    template
+    <
+        class DecoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class file_decoder :
+        public object_decoder<DecoderType, BlockPartitioning>
+    {
+    public:
+
+        /// The base class
+        typedef object_decoder<DecoderType, BlockPartitioning> base_decoder;
+
+        /// The pointer to the decoder
+        typedef typename base_decoder::pointer pointer;
+
+        /// The factory
+        typedef typename base_decoder::factory factory;
+
+        /// Access the partitioning scheme
+        using base_decoder::m_partitioning;
+
+    public:
+
+        /// Constructs a new file decoder, throws std::system_error if
+        /// the file cannot be created with the size of the object
+        /// @param factory The decoder factory to use
+        /// @param filename The file to write the object to, an existing
+        ///        file is truncated
+        /// @param object_size The size of the object to be decoded in bytes
+        file_decoder(factory &factory, const std::string &filename,
+                     uint64_t object_size) :
+            base_decoder(factory, object_size),
+            m_written(m_partitioning.blocks(), false),
+            m_blocks_written(0)
+        {
+            // All offsets in the file must be representable by off_t,
+            // which is 32 bit on some platforms unless large file
+            // support is enabled with _FILE_OFFSET_BITS=64
+            if(object_size >
+               static_cast<uint64_t>(std::numeric_limits<off_t>::max()))
+            {
+                throw_error(EFBIG, "object too large for " + filename);
+            }
+
+            m_file = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                          0644);
+
+            if(m_file < 0)
+            {
+                throw_error(errno, "failed to open " + filename);
+            }
+
+            // Size the file up front so blocks can be written in any order
+            if(ftruncate(m_file, static_cast<off_t>(object_size)) != 0)
+            {
+                int error = errno;
+                close(m_file);
+                throw_error(error, "failed to resize " + filename);
+            }
+        }
+
+        /// Destructor, closes the file
+        ~file_decoder()
+        {
+            close(m_file);
+        }
+
+        /// Returns the decoder of a block, a new decoder is built if the
+        /// block is not in flight. The block must not be written yet.
+        /// @param decoder_id Specifies the decoder to build
+        /// @return The initialized decoder
+        pointer build(uint32_t decoder_id)
+        {
+            assert(decoder_id < m_partitioning.blocks());
+            assert(!m_written[decoder_id]);
+
+            auto it = m_decoders.find(decoder_id);
+
+            if(it != m_decoders.end())
+            {
+                return it->second;
+            }
+
+            pointer decoder = base_decoder::build(decoder_id);
+            m_decoders[decoder_id] = decoder;
+
+            return decoder;
+        }
+
+        /// Passes a payload to the decoder of a block and writes the
+        /// block to the file if the decoder completes. Payloads for
+        /// blocks already written are ignored.
+        /// @param decoder_id The block the payload belongs to
+        /// @param payload The payload, which the decoder may modify
+        void decode(uint32_t decoder_id, uint8_t *payload)
+        {
+            assert(decoder_id < m_partitioning.blocks());
+            assert(payload != 0);
+
+            if(m_written[decoder_id])
+            {
+                return;
+            }
+
+            pointer decoder = build(decoder_id);
+            decoder->decode(payload);
+
+            write_if_complete(decoder_id);
+        }
+
+        /// Writes a block to the file and releases its decoder if the
+        /// decoder is complete. Use this when the decoder returned by
+        /// build() is used directly. If the write fails std::system_error
+        /// is thrown and the block is not marked as written.
+        /// @param decoder_id The block to check
+        /// @return True if the block has been written
+        bool write_if_complete(uint32_t decoder_id)
+        {
+            assert(decoder_id < m_partitioning.blocks());
+
+            if(m_written[decoder_id])
+            {
+                return true;
+            }
+
+            auto it = m_decoders.find(decoder_id);
+
+            if(it == m_decoders.end() || !it->second->is_complete())
+            {
+                return false;
+            }
+
+            write_block(decoder_id, it->second);
+
+            m_written[decoder_id] = true;
+            ++m_blocks_written;
+
+            // Return the decoder to the factory pool
+            m_decoders.erase(it);
+
+            return true;
+        }
+
+        /// @param decoder_id The block to check
+        /// @return True if the block has been written to the file
+        bool is_block_written(uint32_t decoder_id) const
+        {
+            assert(decoder_id < m_partitioning.blocks());
+            return m_written[decoder_id];
+        }
+
+        /// @return The number of blocks written to the file
+        uint32_t blocks_written() const
+        {
+            return m_blocks_written;
+        }
+
+        /// @return The number of decoders currently kept in memory
+        uint32_t blocks_in_flight() const
+        {
+            return static_cast<uint32_t>(m_decoders.size());
+        }
+
+        /// @return True if all blocks have been written to the file
+        bool is_complete() const
+        {
+            return m_blocks_written == m_partitioning.blocks();
+        }
+
+    private:
+
+        /// Writes the decoded symbols of a block at the offset of the
+        /// block in the file
+        /// @param decoder_id The block
+        /// @param decoder The complete decoder of the block
+        void write_block(uint32_t decoder_id, const pointer &decoder)
+        {
+            uint64_t offset = m_partitioning.byte_offset(decoder_id);
+            uint32_t remaining = decoder->bytes_used();
+            uint32_t symbol_size = decoder->symbol_size();
+
+            uint32_t index = 0;
+
+            while(remaining > 0)
+            {
+                m_vectors.clear();
+
+                uint32_t batch = 0;
+
+                while(remaining > 0 && m_vectors.size() < uint32_t(IOV_MAX))
+                {
+                    uint32_t length = std::min(remaining, symbol_size);
+
+                    struct iovec vector;
+                    vector.iov_base = decoder->symbol(index);
+                    vector.iov_len = length;
+
+                    m_vectors.push_back(vector);
+
+                    batch += length;
+                    remaining -= length;
+                    ++index;
+                }
+
+                write_vectors(offset, batch);
+                offset += batch;
+            }
+        }
+
+        /// Writes the collected vectors, retrying short and interrupted
+        /// writes. Throws std::system_error if the write fails.
+        /// @param offset The offset in the file
+        /// @param size The total size of the vectors
+        void write_vectors(uint64_t offset, uint32_t size)
+        {
+            struct iovec *vectors = &m_vectors[0];
+            int count = static_cast<int>(m_vectors.size());
+
+            while(size > 0)
+            {
+                ssize_t written = pwritev(
+                    m_file, vectors, count, static_cast<off_t>(offset));
+
+                if(written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if(written < 0)
+                {
+                    throw_error(errno, "failed to write the decoded block");
+                }
+
+                // No progress would retry forever
+                if(written == 0)
+                {
+                    throw_error(EIO, "failed to write the decoded block");
+                }
+
+                offset += static_cast<uint32_t>(written);
+                size -= static_cast<uint32_t>(written);
+
+                // Skip the vectors written entirely and adjust the
+                // first partially written one
+                while(count > 0 &&
+                      static_cast<size_t>(written) >= vectors->iov_len)
+                {
+                    written -= vectors->iov_len;
+                    ++vectors;
+                    --count;
+                }
+
+                if(count > 0)
+                {
+                    vectors->iov_base =
+                        static_cast<uint8_t*>(vectors->iov_base) + written;
+                    vectors->iov_len -= written;
+                }
+            }
+        }
+
+        /// Throws a std::system_error
+        /// @param error The errno value of the failure
+        /// @param what The description of the failure
+        static void throw_error(int error, const std::string &what)
+        {
+            throw std::system_error(error, std::generic_category(), what);
+        }
+
+    private:
+
+        /// The file descriptor of the output file
+        int m_file;
+
+        /// The decoders of the blocks in flight
+        std::map<uint32_t, pointer> m_decoders;
+
+        /// Tracks the blocks written to the file
+        std::vector<bool> m_written;
+
+        /// The number of blocks written to the file
+        uint32_t m_blocks_written;
+
+        /// The vectors of a write
+        std::vector<struct iovec> m_vectors;
+
+    };
+
+}
@@ -61,7 +61,7 @@ namespace kodo
             auto position = m_file->tellg();
             assert(position >= 0);
 
-            m_file_size = static_cast<uint32_t>(position);
+            m_file_size = static_cast<uint64_t>(position);
             assert(m_file_size > 0);
             assert(data_size > 0);
 
@@ -69,7 +69,7 @@ namespace kodo
         }
 
         /// @return the size in bytes of the file
-        uint32_t size() const
+        uint64_t size() const
         {
             return m_file_size;
         }
@@ -78,7 +78,7 @@ namespace kodo
         /// @param encoder to be initialized
         /// @param offset in bytes into the storage object
         /// @param size the number of bytes to use
-        void read(pointer &encoder, uint32_t offset, uint32_t size)
+        void read(pointer &encoder, uint64_t offset, uint32_t size)
         {
             assert(encoder);
             assert(offset < m_file_size);
@@ -89,10 +89,10 @@ namespace kodo
             uint32_t data_size = m_data.size();
             assert(size <= data_size);
 
-            uint32_t remaining_bytes = m_file_size - offset;
+            uint64_t remaining_bytes = m_file_size - offset;
             assert(size <= remaining_bytes);
 
-            m_file->seekg(offset, std::ios::beg);
+            m_file->seekg(static_cast<std::streamoff>(offset), std::ios::beg);
             assert(m_file);
 
             m_file->read(reinterpret_cast<char*>(&m_data[0]), size);
@@ -114,7 +114,7 @@ namespace kodo
         boost::shared_ptr<std::ifstream> m_file;
 
         /// The size of the file in bytes
-        uint32_t m_file_size;
+        uint64_t m_file_size;
 
         /// Intermediate buffer used for reading from the file and
         /// swapping into the encoders - avoid any additional copies of
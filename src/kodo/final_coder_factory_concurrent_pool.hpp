@@ -0,0 +1,174 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include "concurrent_resource_pool.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup factory_layers
+    /// Terminates the layered coder and contains the coder final
+    /// factory. Like the final_coder_factory_pool the factory recycles
+    /// encoders/decoders, but the concurrent_resource_pool used allows
+    /// several threads to build() and release coders from the same
+    /// factory. The factory must not be reconfigured e.g. with
+    /// set_symbols() while other threads build coders, and the factory
+    /// layers of the stack must not modify shared state in build().
+    template<class FinalType>
+    class final_coder_factory_concurrent_pool
+    {
+    public:
+
+        /// Pointer type to the constructed coder
+        typedef boost::shared_ptr<FinalType> pointer;
+
+        /// @ingroup factory_layers
+        /// The final factory
+        class factory
+        {
+        public:
+
+            /// The factory type
+            typedef typename FinalType::factory factory_type;
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size) :
+                m_pool(boost::bind(&factory::make_coder, this))
+            {
+                (void) max_symbols;
+                (void) max_symbol_size;
+            }
+
+            /// @copydoc layer::factory::build()
+            pointer build()
+            {
+                factory_type *this_factory =
+                    static_cast<factory_type*>(this);
+
+                pointer coder = m_pool.allocate();
+                coder->initialize(*this_factory);
+
+                return coder;
+            }
+
+            /// Constructs coders in advance so that the following
+            /// calls to build() do not allocate memory
+            /// @param coders The number of unused coders wanted in the
+            ///        pool
+            void reserve(uint32_t coders)
+            {
+                m_pool.reserve(coders);
+            }
+
+            /// Limits the number of unused coders kept, coders released
+            /// when the pool is full are deleted
+            /// @param coders The maximum number of unused coders
+            void set_max_pooled(uint32_t coders)
+            {
+                m_pool.set_max_pooled(coders);
+            }
+
+            /// @return The maximum number of unused coders kept
+            uint32_t max_pooled() const
+            {
+                return m_pool.max_pooled();
+            }
+
+            /// @return A reference to the internal resource pool
+            const concurrent_resource_pool<FinalType>& pool() const
+            {
+                return m_pool;
+            }
+
+            /// @return A reference to the internal resource pool
+            concurrent_resource_pool<FinalType>& pool()
+            {
+                return m_pool;
+            }
+
+
+        private: // Make non-copyable
+
+            /// Copy constructor
+            factory(const factory&);
+
+            /// Copy assignment
+            const factory& operator=(const factory&);
+
+        private:
+
+            /// Factory function used by the resource pool to
+            /// build new coders if needed.
+            /// @param max_symbols The maximum symbols that are supported
+            /// @param max_symbol_size The maximum size of a symbol in
+            ///        bytes
+            static pointer make_coder(factory *f_ptr)
+            {
+                factory_type *this_factory =
+                    static_cast<factory_type*>(f_ptr);
+
+                pointer coder = boost::make_shared<FinalType>();
+                coder->construct(*this_factory);
+
+                return coder;
+            }
+
+        private:
+
+            /// Resource pool for the coders
+            concurrent_resource_pool<FinalType> m_pool;
+
+        };
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            // This is the final factory layer so we do nothing
+            (void) the_factory;
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory& the_factory)
+        {
+            // This is the final factory layer so we do nothing
+            (void) the_factory;
+        }
+
+    protected:
+
+        /// Constructor
+        final_coder_factory_concurrent_pool()
+        { }
+
+        /// Destructor
+        ~final_coder_factory_concurrent_pool()
+        { }
+
+    private: // Make non-copyable
+
+        /// Copy constructor
+        final_coder_factory_concurrent_pool(
+            const final_coder_factory_concurrent_pool&);
+
+        /// Copy assignment
+        const final_coder_factory_concurrent_pool& operator=(
+            const final_coder_factory_concurrent_pool&);
+
+    };
+}
+
+
@@ -7,10 +7,11 @@
 
 #include <cstdint>
 
+#include <boost/bind.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
-#include <sak/resource_pool.hpp>
+#include "bounded_resource_pool.hpp"
 
 namespace kodo
 {
@@ -19,6 +20,8 @@ namespace kodo
     /// Terminates the layered coder and contains the coder final
     /// factory. The pool factory uses a memory pool to recycle
     /// encoders/decoders, and thereby minimize memory consumption.
+    /// The pool may be filled at startup with reserve() and its size
+    /// limited with set_max_pooled().
     template<class FinalType>
     class final_coder_factory_pool
     {
@@ -56,14 +59,37 @@ namespace kodo
                 return coder;
             }
 
+            /// Constructs coders in advance so that the following
+            /// calls to build() do not allocate memory
+            /// @param coders The number of unused coders wanted in the
+            ///        pool
+            void reserve(uint32_t coders)
+            {
+                m_pool.reserve(coders);
+            }
+
+            /// Limits the number of unused coders kept, coders released
+            /// when the pool is full are deleted
+            /// @param coders The maximum number of unused coders
+            void set_max_pooled(uint32_t coders)
+            {
+                m_pool.set_max_pooled(coders);
+            }
+
+            /// @return The maximum number of unused coders kept
+            uint32_t max_pooled() const
+            {
+                return m_pool.max_pooled();
+            }
+
             /// @return A reference to the internal resource pool
-            const sak::resource_pool<FinalType>& pool() const
+            const bounded_resource_pool<FinalType>& pool() const
             {
                 return m_pool;
             }
 
             /// @return A reference to the internal resource pool
-            sak::resource_pool<FinalType>& pool()
+            bounded_resource_pool<FinalType>& pool()
             {
                 return m_pool;
             }
@@ -98,7 +124,7 @@ namespace kodo
         private:
 
             /// Resource pool for the coders
-            sak::resource_pool<FinalType> m_pool;
+            bounded_resource_pool<FinalType> m_pool;
 
         };
 
@@ -0,0 +1,170 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "bit_scan.hpp"
+
+namespace kodo
+{
+
+    /// Helper describing how the elements of a finite field are packed
+    /// in a coefficient vector, used when scanning a vector a machine
+    /// word at a time.
+    template<class Field>
+    struct coefficient_packing
+    {
+        /// The number of elements stored in one 64 bit word
+        static const uint32_t word_elements =
+            fifi::is_binary<Field>::value ?
+            64 : 8 / sizeof(typename Field::value_type);
+
+        /// @param index The index of an element, which must be the first
+        ///        element of a word
+        /// @return The byte offset of the element in the vector
+        static uint32_t offset(uint32_t index)
+        {
+            return fifi::is_binary<Field>::value ?
+                index / 8 : index * sizeof(typename Field::value_type);
+        }
+
+        /// @param coefficients The coefficient vector
+        /// @param index The index of the first element of the word
+        /// @return True if all elements of the word are zero
+        static bool is_zero_word(
+            const typename Field::value_type *coefficients, uint32_t index)
+        {
+            uint64_t word;
+            std::memcpy(&word, reinterpret_cast<const uint8_t*>(
+                            coefficients) + offset(index), sizeof(word));
+
+            return word == 0;
+        }
+    };
+
+    template<class Field>
+    const uint32_t coefficient_packing<Field>::word_elements;
+
+    /// Finds the first non-zero coefficient in the range [begin, end).
+    /// Zero words are skipped 64 bits at a time and for the binary field
+    /// the bit within a non-zero byte is found using a bit scan.
+    ///
+    /// @param coefficients The coefficient vector
+    /// @param begin The first index to look at
+    /// @param end One past the last index to look at
+    /// @return The index of the first non-zero coefficient or end if all
+    ///         coefficients in the range are zero
+    template<class Field>
+    inline uint32_t find_nonzero(
+        const typename Field::value_type *coefficients,
+        uint32_t begin, uint32_t end)
+    {
+        assert(coefficients != 0);
+
+        typedef coefficient_packing<Field> packing;
+
+        uint32_t i = begin;
+
+        while(i < end)
+        {
+            if(i % packing::word_elements == 0 &&
+               end - i >= packing::word_elements)
+            {
+                if(packing::is_zero_word(coefficients, i))
+                {
+                    i += packing::word_elements;
+                    continue;
+                }
+            }
+
+            if(fifi::is_binary<Field>::value && i % 8 == 0 && end - i >= 8)
+            {
+                // The binary field stores the first element in the
+                // least significant bit of each byte
+                uint8_t byte = coefficients[i / 8];
+
+                if(byte == 0)
+                {
+                    i += 8;
+                    continue;
+                }
+
+                return i + count_trailing_zeros(byte);
+            }
+
+            if(fifi::get_value<Field>(coefficients, i))
+            {
+                return i;
+            }
+
+            ++i;
+        }
+
+        return end;
+    }
+
+    /// Finds the last non-zero coefficient in the range [begin, end).
+    /// @see find_nonzero()
+    ///
+    /// @param coefficients The coefficient vector
+    /// @param begin The first index to look at
+    /// @param end One past the last index to look at
+    /// @return The index of the last non-zero coefficient or end if all
+    ///         coefficients in the range are zero
+    template<class Field>
+    inline uint32_t rfind_nonzero(
+        const typename Field::value_type *coefficients,
+        uint32_t begin, uint32_t end)
+    {
+        assert(coefficients != 0);
+
+        typedef coefficient_packing<Field> packing;
+
+        uint32_t i = end;
+
+        while(i > begin)
+        {
+            if(i % packing::word_elements == 0 &&
+               i - begin >= packing::word_elements)
+            {
+                if(packing::is_zero_word(
+                       coefficients, i - packing::word_elements))
+                {
+                    i -= packing::word_elements;
+                    continue;
+                }
+            }
+
+            if(fifi::is_binary<Field>::value && i % 8 == 0 && i - begin >= 8)
+            {
+                uint8_t byte = coefficients[i / 8 - 1];
+
+                if(byte == 0)
+                {
+                    i -= 8;
+                    continue;
+                }
+
+                return i - 8 + most_significant_bit(byte);
+            }
+
+            if(fifi::get_value<Field>(coefficients, i - 1))
+            {
+                return i - 1;
+            }
+
+            --i;
+        }
+
+        return end;
+    }
+
+}
@@ -11,6 +11,8 @@
 #include <fifi/arithmetics.hpp>
 #include <fifi/fifi_utils.hpp>
 
+#include "field_registry.hpp"
+
 namespace kodo
 {
 
@@ -48,8 +50,9 @@ namespace kodo
     public:
 
         /// @ingroup factory_layers
-        /// The factory layer associated with this coder. We create
-        /// an instance of the used field and share this with all coders
+        /// The factory layer associated with this coder. The instance of
+        /// the used field is taken from the field_registry and shared
+        /// with all coders and other factories
         class factory : public SuperCoder::factory
         {
         public:
@@ -58,7 +61,7 @@ namespace kodo
             factory(uint32_t max_symbols, uint32_t max_symbol_size) :
                 SuperCoder::factory(max_symbols, max_symbol_size)
             {
-                m_field = boost::make_shared<field_impl>();
+                m_field = field_registry<field_impl>::get();
             }
 
         private:
@@ -182,6 +185,16 @@ namespace kodo
             return m_field->invert( value );
         }
 
+        /// Gives layers with their own temporary buffers access to the
+        /// field, e.g. to call fifi::multiply_subtract() on regions
+        /// longer than the temporary symbol of this layer.
+        /// @return The finite field implementation used
+        field_impl& field()
+        {
+            assert(m_field);
+            return *m_field;
+        }
+
     private:
 
         /// The selected field
@@ -8,6 +8,8 @@
 #include <cstdint>
 #include <algorithm>
 
+#include "find_nonzero.hpp"
+
 namespace kodo
 {
 
@@ -61,6 +63,15 @@ namespace kodo
             return m_start;
         }
 
+        /// Advance the policy to the next non-zero coefficient, if no
+        /// such coefficient exists the policy will be at the end
+        /// @param coefficients The coefficient vector
+        template<class Field>
+        void skip_zeros(const typename Field::value_type *coefficients)
+        {
+            m_start = find_nonzero<Field>(coefficients, m_start, m_stop + 1);
+        }
+
         /// @param a The first value
         /// @param b The second value
         /// @return the maximum value of the two input values
@@ -0,0 +1,264 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "pivot_bitmap.hpp"
+#include "xoshiro256_generator_policy.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Generates uniformly distributed coefficients with a
+    /// specific density by jumping directly between the non-zero
+    /// positions.
+    ///
+    /// Every coefficient is non-zero with probability equal to the
+    /// density, as with the sparse_uniform_generator, but instead of a
+    /// Bernoulli draw per symbol the distance to the next non-zero
+    /// position is drawn from the geometric distribution. Generating a
+    /// vector therefore takes a number of random draws proportional to
+    /// the number of non-zero coefficients.
+    ///
+    /// The positions of the non-zero coefficients of the last vector
+    /// generated are available through nonzero_positions(). Layers
+    /// above can pass them to layer::encode_sparse_symbol() so the
+    /// encoder does not have to scan the vector, as done by the
+    /// sparse_symbol_id_writer.
+    template<class GeneratorPolicy, class SuperCoder>
+    class basic_geometric_sparse_generator : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// The random generator used
+        typedef GeneratorPolicy generator_type;
+
+        /// @copydoc layer::seed_type
+        typedef typename generator_type::seed_type seed_type;
+
+    public:
+
+        /// Constructor
+        basic_geometric_sparse_generator()
+            : m_value_distribution(1, field_type::max_value),
+              m_nonzero_count(0)
+        {
+            set_density(0.5);
+        }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_positions.resize(the_factory.max_symbols(), 0);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_nonzero_count = 0;
+        }
+
+        /// @copydoc layer::generate(uint8_t*)
+        void generate(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            // Since we will not set all coefficients we should ensure
+            // that the non specified ones are zero
+            std::fill_n(coefficients, SuperCoder::coefficients_size(), 0);
+
+            value_type *c = reinterpret_cast<value_type*>(coefficients);
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            m_nonzero_count = 0;
+
+            for(uint32_t i = next_position(0, symbols); i < symbols;
+                i = next_position(i + 1, symbols))
+            {
+                set_coefficient(c, i);
+            }
+        }
+
+        /// @copydoc layer::generate_partial(uint8_t*)
+        void generate_partial(uint8_t *coefficients)
+        {
+            assert(coefficients != 0);
+
+            std::fill_n(coefficients, SuperCoder::coefficients_size(), 0);
+
+            value_type *c = reinterpret_cast<value_type*>(coefficients);
+
+            const pivot_bitmap &pivots = SuperCoder::symbol_pivots();
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            m_nonzero_count = 0;
+
+            // Every position is drawn independently so dropping the
+            // symbols not available keeps the density of the rest
+            for(uint32_t i = next_position(0, symbols); i < symbols;
+                i = next_position(i + 1, symbols))
+            {
+                if(pivots.test(i))
+                {
+                    set_coefficient(c, i);
+                }
+            }
+        }
+
+        /// @copydoc layer::seed(seed_type)
+        void seed(seed_type seed_value)
+        {
+            m_random_generator.seed(seed_value);
+        }
+
+        /// @copydoc layer::nonzero_positions() const
+        const uint32_t* nonzero_positions() const
+        {
+            assert(m_positions.size() > 0);
+            return &m_positions[0];
+        }
+
+        /// @copydoc layer::nonzero_count() const
+        uint32_t nonzero_count() const
+        {
+            return m_nonzero_count;
+        }
+
+        /// Set the density of the coefficients generated
+        /// @param density coefficients density
+        void set_density(double density)
+        {
+            assert(density > 0);
+            assert(density <= 1);
+
+            m_density = density;
+
+            // The logarithm of the probability of a zero coefficient,
+            // minus infinity when every coefficient is non-zero
+            m_log_zero = std::log1p(-density);
+        }
+
+        /// Get the density of the coefficients generated
+        /// @return the density of the generator
+        double get_density() const
+        {
+            return m_density;
+        }
+
+    protected:
+
+        /// Draws the next non-zero position
+        /// @param index The first position which may be drawn
+        /// @param symbols The number of symbols
+        /// @return The next non-zero position or a value greater than or
+        ///         equal to symbols if there is none
+        uint32_t next_position(uint32_t index, uint32_t symbols)
+        {
+            if(index >= symbols || m_density >= 1)
+            {
+                return index;
+            }
+
+            // The number of zero coefficients before the next non-zero
+            // one is geometrically distributed, 1 - u is in (0,1]
+            double u = 1.0 - m_uniform(m_random_generator);
+            double skip = std::floor(std::log(u) / m_log_zero);
+
+            if(skip >= double(symbols - index))
+            {
+                return symbols;
+            }
+
+            return index + uint32_t(skip);
+        }
+
+        /// Sets a random non-zero coefficient and records its position
+        /// @param c The coefficient vector
+        /// @param index The position of the coefficient
+        void set_coefficient(value_type *c, uint32_t index)
+        {
+            if(fifi::is_binary<field_type>::value)
+            {
+                fifi::set_value<field_type>(c, index, 1);
+            }
+            else
+            {
+                value_type coefficient =
+                    m_value_distribution(m_random_generator);
+
+                fifi::set_value<field_type>(c, index, coefficient);
+            }
+
+            m_positions[m_nonzero_count] = index;
+            ++m_nonzero_count;
+        }
+
+    private:
+
+        /// The density of the coefficients
+        double m_density;
+
+        /// The natural logarithm of one minus the density
+        double m_log_zero;
+
+        /// Distribution used for drawing the distance between the
+        /// non-zero positions
+        boost::random::uniform_real_distribution<double> m_uniform;
+
+        /// The type of the value_type distribution
+        typedef boost::random::uniform_int_distribution<value_type>
+            value_type_distribution;
+
+        /// Distribution that generates the non-zero values
+        value_type_distribution m_value_distribution;
+
+        /// The random generator
+        generator_type m_random_generator;
+
+        /// The positions of the non-zero coefficients of the last vector
+        std::vector<uint32_t> m_positions;
+
+        /// The number of non-zero coefficients of the last vector
+        uint32_t m_nonzero_count;
+
+    };
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Geometric sparse generator using the
+    /// xoshiro256_generator_policy
+    template<class SuperCoder>
+    class geometric_sparse_generator : public
+        basic_geometric_sparse_generator<
+            xoshiro256_generator_policy, SuperCoder>
+    { };
+
+}
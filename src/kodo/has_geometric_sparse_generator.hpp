@@ -0,0 +1,40 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "geometric_sparse_generator.hpp"
+
+namespace kodo
+{
+    /// Type trait helper allows compile time detection of whether an
+    /// encoder contains the basic_geometric_sparse_generator layer and
+    /// therefore provides the positions of the non-zero coefficients
+    /// through layer::nonzero_positions()
+    ///
+    /// Example:
+    ///
+    /// typedef kodo::sparse_full_rlnc_encoder<fifi::binary8> encoder_t;
+    ///
+    /// if(kodo::has_geometric_sparse_generator<encoder_t>::value)
+    /// {
+    ///     // Do something here
+    /// }
+    ///
+    template<class T>
+    struct has_geometric_sparse_generator
+    {
+        template<class P, class U>
+        static uint8_t test(
+            const kodo::basic_geometric_sparse_generator<P, U> *);
+
+        static uint32_t test(...);
+
+        static const bool value = sizeof(test(static_cast<T*>(0))) == 1;
+    };
+
+}
+
+
@@ -0,0 +1,191 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "find_nonzero.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup codec_layers
+    /// @brief Checks whether an encoded symbol is innovative using only
+    ///        its coding coefficients before any work is done on the
+    ///        symbol data.
+    ///
+    /// A linear block decoder normally updates the coding coefficients
+    /// and the symbol data together for every pivot it eliminates. When
+    /// the symbol turns out to be non-innovative, which is the common
+    /// case towards the end of a generation, all the work done on the
+    /// symbol data is wasted. This layer first eliminates the current
+    /// pivots from the coding coefficients only while recording the
+    /// pivots and coefficients used. If the coefficients are reduced
+    /// to zero the symbol is dropped without touching the symbol data.
+    /// Otherwise the recorded operations are replayed on the symbol
+    /// data and the reduced symbol is passed to the decoder.
+    ///
+    /// The layer relies on the decoding matrix being kept in reduced
+    /// echelon form, see the batch_linear_block_decoder for details.
+    template<class SuperCoder>
+    class innovation_check_decoder : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename field_type::value_type value_type;
+
+    public:
+
+        /// Constructor
+        innovation_check_decoder()
+            : m_operations(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_pivots.resize(the_factory.max_symbols(), 0);
+            m_values.resize(the_factory.max_symbols(), 0);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
+        void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(SuperCoder::is_complete())
+            {
+                return;
+            }
+
+            value_type *symbol =
+                reinterpret_cast<value_type*>(symbol_data);
+
+            value_type *vector =
+                reinterpret_cast<value_type*>(coefficients);
+
+            if(!reduce_coefficients(vector))
+            {
+                return;
+            }
+
+            reduce_symbol(symbol);
+
+            SuperCoder::decode_symbol(symbol_data, coefficients);
+        }
+
+        /// @copydoc layer::decode_symbol(uint8_t*,uint32_t)
+        void decode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            SuperCoder::decode_symbol(symbol_data, symbol_index);
+        }
+
+    protected:
+
+        /// Eliminates the current pivots from the coding coefficients
+        /// and records the operations performed
+        /// @param vector The coding coefficients of the symbol
+        /// @return True if the symbol is innovative i.e. the reduced
+        ///         coefficients contain a non-zero value
+        bool reduce_coefficients(value_type *vector)
+        {
+            assert(vector != 0);
+
+            uint32_t coefficients_length = SuperCoder::coefficients_length();
+
+            bool innovative = false;
+            m_operations = 0;
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t i = find_nonzero<field_type>(vector, 0, symbols);
+                i < symbols;
+                i = find_nonzero<field_type>(vector, i + 1, symbols))
+            {
+                value_type value = fifi::get_value<field_type>(vector, i);
+
+                if(!SuperCoder::symbol_pivot(i))
+                {
+                    // Since the pivot rows are fully reduced the value
+                    // will not be changed by the remaining pivots
+                    innovative = true;
+                    continue;
+                }
+
+                const value_type *vector_i =
+                    SuperCoder::coefficients_value(i);
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(
+                        vector, vector_i, coefficients_length);
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(
+                        vector, vector_i, value, coefficients_length);
+                }
+
+                m_pivots[m_operations] = i;
+                m_values[m_operations] = value;
+                ++m_operations;
+            }
+
+            return innovative;
+        }
+
+        /// Replays the operations recorded by reduce_coefficients() on
+        /// the symbol data
+        /// @param symbol The symbol data
+        void reduce_symbol(value_type *symbol)
+        {
+            assert(symbol != 0);
+
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            for(uint32_t k = 0; k < m_operations; ++k)
+            {
+                const value_type *symbol_i =
+                    SuperCoder::symbol_value(m_pivots[k]);
+
+                if(fifi::is_binary<field_type>::value)
+                {
+                    SuperCoder::subtract(symbol, symbol_i, symbol_length);
+                }
+                else
+                {
+                    SuperCoder::multiply_subtract(
+                        symbol, symbol_i, m_values[k], symbol_length);
+                }
+            }
+        }
+
+    private:
+
+        /// The pivots eliminated from the current symbol
+        std::vector<uint32_t> m_pivots;
+
+        /// The coefficients used when eliminating the pivots
+        std::vector<value_type> m_values;
+
+        /// The number of operations recorded
+        uint32_t m_operations;
+
+    };
+
+}
@@ -6,12 +6,23 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/optional.hpp>
 
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include <sak/aligned_allocator.hpp>
+
+#include "bit_scan.hpp"
+#include "padded_size.hpp"
+#include "thread_pool.hpp"
+
 namespace kodo
 {
 
@@ -22,6 +33,19 @@ namespace kodo
     /// effect and can therefore improve the decoding throughput when
     /// decoding sparse symbols, in particular if the generation size
     /// is large.
+    ///
+    /// For the binary field the final backward substitution uses the
+    /// Method of Four Russians (M4RI): the pivot rows are processed in
+    /// groups of k and a Gray code ordered table of all 2^k combinations
+    /// of the group's symbols is built, after which the group is
+    /// eliminated from every other row with a single table lookup and
+    /// one symbol subtraction instead of up to k.
+    ///
+    /// Once the decoder becomes complete all remaining work is done at
+    /// once which can cause a latency spike for large generations. A
+    /// thread pool may therefore be set with set_thread_pool(), in which
+    /// case the operations are first performed on the coefficients and
+    /// then applied to the symbol data in byte stripes, one per thread.
     template<class SuperCoder>
     class linear_block_decoder_delayed : public SuperCoder
     {
@@ -36,8 +60,96 @@ namespace kodo
         ///
         typedef typename SuperCoder::direction_policy direction_policy;
 
+        /// The largest number of pivot rows combined in one table
+        static const uint32_t max_table_bits = 8;
+
+        /// The maximum size of the table in bytes, chosen so that the
+        /// table stays in cache while a group is eliminated
+        static const uint32_t max_table_size = 1 << 20;
+
+        /// The smallest stripe of the symbol data in bytes given to a
+        /// thread, smaller symbols are not split
+        static const uint32_t min_stripe_size = 4096;
+
+        /// Pointer to the thread pool
+        typedef boost::shared_ptr<thread_pool> thread_pool_pointer;
+
     public:
 
+        /// Constructor
+        linear_block_decoder_delayed()
+            : m_table_bits(0),
+              m_table_stride(0),
+              m_group_begin(0),
+              m_group_end(0)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_operations.reserve(2 * the_factory.max_symbols());
+            m_eliminations.reserve(the_factory.max_symbols());
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                uint32_t max_symbol_size = the_factory.max_symbol_size();
+
+                uint32_t bits = table_bits(
+                    the_factory.max_symbols(), max_symbol_size);
+
+                m_table.resize((1U << bits) * padded_size(max_symbol_size));
+            }
+            else
+            {
+                m_scratch.resize(fifi::size_to_length<field_type>(
+                                     the_factory.max_symbol_size()));
+            }
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                m_table_stride = padded_size(SuperCoder::symbol_size());
+
+                m_table_bits = table_bits(
+                    SuperCoder::symbols(), SuperCoder::symbol_size());
+
+                // A smaller generation may allow more bits than the
+                // table was allocated for
+                while((1U << m_table_bits) * m_table_stride > m_table.size())
+                {
+                    --m_table_bits;
+                }
+
+                assert(m_table_bits > 0);
+            }
+        }
+
+        /// Sets the thread pool used to split the final backward
+        /// substitution into stripes of the symbol data. The pool may be
+        /// shared between decoders.
+        /// @param pool The thread pool or a null pointer to perform the
+        ///        substitution on the calling thread only
+        void set_thread_pool(const thread_pool_pointer &pool)
+        {
+            m_thread_pool = pool;
+        }
+
+        /// @return The thread pool used for the final backward
+        ///         substitution, or a null pointer if none is set
+        const thread_pool_pointer& get_thread_pool() const
+        {
+            return m_thread_pool;
+        }
+
         /// @copydoc layer::decode_symbol(uint8_t*,uint8_t*)
         void decode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
         {
@@ -78,7 +190,8 @@ namespace kodo
                 // We have increased the rank
                 ++m_rank;
 
-                m_uncoded[ symbol_index ] = true;
+                m_uncoded.set(symbol_index);
+                m_pivots.set(symbol_index);
 
                 m_maximum_pivot =
                     direction_policy::max(symbol_index, m_maximum_pivot);
@@ -99,6 +212,7 @@ namespace kodo
         using SuperCoder::m_maximum_pivot;
         using SuperCoder::m_coded;
         using SuperCoder::m_uncoded;
+        using SuperCoder::m_pivots;
 
     protected:
 
@@ -135,7 +249,8 @@ namespace kodo
             // We have increased the rank
             ++m_rank;
 
-            m_coded[ *pivot_index ] = true;
+            m_coded.set(*pivot_index);
+            m_pivots.set(*pivot_index);
 
             m_maximum_pivot =
                 direction_policy::max(*pivot_index, m_maximum_pivot);
@@ -155,6 +270,18 @@ namespace kodo
         {
             assert(SuperCoder::is_complete());
 
+            if(fifi::is_binary<field_type>::value)
+            {
+                table_backward_substitute();
+                return;
+            }
+
+            if(m_thread_pool)
+            {
+                striped_backward_substitute();
+                return;
+            }
+
             uint32_t start = direction_policy::min(0, SuperCoder::symbols()-1);
             uint32_t end = direction_policy::max(0, SuperCoder::symbols()-1);
 
@@ -172,6 +299,388 @@ namespace kodo
                     symbol_i, vector_i, i);
             }
         }
+
+        /// Performs the final backward substitution on the coefficients
+        /// while recording the row operations, which are then replayed
+        /// on stripes of the symbol data by the thread pool. The
+        /// operations are replayed whenever a generation's worth has been
+        /// recorded to bound the memory used.
+        void striped_backward_substitute()
+        {
+            uint32_t symbols = SuperCoder::symbols();
+
+            uint32_t start = direction_policy::min(0, symbols - 1);
+            uint32_t end = direction_policy::max(0, symbols - 1);
+
+            m_operations.clear();
+
+            for(direction_policy p(start, end); !p.at_end(); p.advance())
+            {
+                substitute_coefficients(p.index());
+
+                if(m_operations.size() >= symbols)
+                {
+                    run_striped(&linear_block_decoder_delayed::
+                                replay_operations);
+                    m_operations.clear();
+                }
+            }
+
+            run_striped(&linear_block_decoder_delayed::replay_operations);
+            m_operations.clear();
+        }
+
+        /// Eliminates a pivot from the coefficients of the other coded
+        /// rows and records the operations needed on the symbol data
+        /// @param pivot_index The pivot to eliminate
+        void substitute_coefficients(uint32_t pivot_index)
+        {
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t coefficients_length = SuperCoder::coefficients_length();
+
+            const value_type *vector_pivot =
+                SuperCoder::coefficients_value(pivot_index);
+
+            for(uint32_t j = m_coded.find_next(0); j < symbols;
+                j = m_coded.find_next(j + 1))
+            {
+                if(j == pivot_index)
+                {
+                    continue;
+                }
+
+                value_type *vector_j = SuperCoder::coefficients_value(j);
+
+                value_type value =
+                    fifi::get_value<field_type>(vector_j, pivot_index);
+
+                if(!value)
+                {
+                    continue;
+                }
+
+                SuperCoder::multiply_subtract(
+                    vector_j, vector_pivot, value, coefficients_length);
+
+                row_operation operation = { j, pivot_index, value };
+                m_operations.push_back(operation);
+            }
+        }
+
+        /// Replays the recorded operations on a stripe of the symbols
+        /// @param offset The first element of the stripe
+        /// @param length The number of elements in the stripe
+        void replay_operations(uint32_t offset, uint32_t length)
+        {
+            for(uint32_t k = 0; k < m_operations.size(); ++k)
+            {
+                const row_operation &operation = m_operations[k];
+
+                // The multiply_subtract() of the finite field math uses a
+                // temporary buffer shared by the coder, so the stripes
+                // multiply into their own part of the scratch buffer
+                value_type *scratch = &m_scratch[offset];
+
+                const value_type *symbol_source =
+                    SuperCoder::symbol_value(operation.m_source) + offset;
+
+                std::copy(symbol_source, symbol_source + length, scratch);
+
+                SuperCoder::multiply(scratch, operation.m_value, length);
+
+                SuperCoder::subtract(
+                    SuperCoder::symbol_value(operation.m_row) + offset,
+                    scratch, length);
+            }
+        }
+
+        /// Performs the final backward substitution for the binary field
+        /// a group of pivot rows at a time. The groups are visited in the
+        /// opposite direction of the forward substitution, so that the
+        /// rows of a group have no non-zero coefficients outside the
+        /// group once the group itself has been reduced. The work on the
+        /// coefficients is done first, after which the symbol data is
+        /// updated in stripes.
+        void table_backward_substitute()
+        {
+            assert(m_table_bits > 0);
+
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t groups = (symbols + m_table_bits - 1) / m_table_bits;
+
+            // The forward policy leaves the coding matrix upper
+            // triangular and the backward policy lower triangular
+            bool upper = direction_policy::min(0, symbols - 1) == 0;
+
+            for(uint32_t g = 0; g < groups; ++g)
+            {
+                uint32_t group = upper ? groups - g - 1 : g;
+
+                m_group_begin = group * m_table_bits;
+                m_group_end = std::min(m_group_begin + m_table_bits, symbols);
+
+                m_operations.clear();
+                m_eliminations.clear();
+
+                reduce_group();
+                select_entries();
+
+                run_striped(&linear_block_decoder_delayed::replay_group);
+            }
+
+            m_operations.clear();
+            m_eliminations.clear();
+        }
+
+        /// Reduces the coefficients of the rows of the current group
+        /// among themselves, so that they become the identity within
+        /// the group, and records the operations performed
+        void reduce_group()
+        {
+            uint32_t coefficients_length = SuperCoder::coefficients_length();
+
+            for(uint32_t i = m_group_begin; i < m_group_end; ++i)
+            {
+                const value_type *vector_i = SuperCoder::coefficients_value(i);
+
+                for(uint32_t j = m_group_begin; j < m_group_end; ++j)
+                {
+                    if(j == i || !m_coded[j])
+                    {
+                        continue;
+                    }
+
+                    value_type *vector_j = SuperCoder::coefficients_value(j);
+
+                    if(!fifi::get_value<field_type>(vector_j, i))
+                    {
+                        continue;
+                    }
+
+                    SuperCoder::subtract(
+                        vector_j, vector_i, coefficients_length);
+
+                    row_operation operation = { j, i, 1U };
+                    m_operations.push_back(operation);
+                }
+            }
+        }
+
+        /// Clears the pivots of the current group from the coefficients
+        /// of all other coded rows and records which table entry must
+        /// be subtracted from each row's symbol
+        void select_entries()
+        {
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t j = m_coded.find_next(0); j < symbols;
+                j = m_coded.find_next(j + 1))
+            {
+                if(j >= m_group_begin && j < m_group_end)
+                {
+                    continue;
+                }
+
+                value_type *vector_j = SuperCoder::coefficients_value(j);
+
+                uint32_t entry = 0;
+
+                for(uint32_t i = m_group_begin; i < m_group_end; ++i)
+                {
+                    if(fifi::get_value<field_type>(vector_j, i))
+                    {
+                        entry |= 1U << (i - m_group_begin);
+
+                        // The group rows are unit vectors at this point
+                        // so subtracting them only clears the pivot
+                        fifi::set_value<field_type>(vector_j, i, 0U);
+                    }
+                }
+
+                if(entry != 0)
+                {
+                    row_operation elimination = { j, entry, 1U };
+                    m_eliminations.push_back(elimination);
+                }
+            }
+        }
+
+        /// Updates a stripe of the symbol data for the current group:
+        /// replays the group reduction, builds the stripe of the table
+        /// of all combinations of the group's symbols and subtracts the
+        /// selected entries. Entry m of the table holds the sum of the
+        /// symbols whose bit is set in m. Visiting the entries in Gray
+        /// code order means each entry is a single subtraction away from
+        /// the previous one.
+        /// @param offset The first element of the stripe
+        /// @param length The number of elements in the stripe
+        void replay_group(uint32_t offset, uint32_t length)
+        {
+            for(uint32_t k = 0; k < m_operations.size(); ++k)
+            {
+                const row_operation &operation = m_operations[k];
+
+                SuperCoder::subtract(
+                    SuperCoder::symbol_value(operation.m_row) + offset,
+                    SuperCoder::symbol_value(operation.m_source) + offset,
+                    length);
+            }
+
+            uint32_t entries = 1U << (m_group_end - m_group_begin);
+
+            std::fill_n(table_entry(0) + offset, length, 0);
+
+            uint32_t previous = 0;
+
+            for(uint32_t k = 1; k < entries; ++k)
+            {
+                uint32_t gray = k ^ (k >> 1);
+
+                // Consecutive Gray codes differ in the lowest set bit
+                // of k
+                uint32_t bit = count_trailing_zeros(k);
+
+                value_type *entry = table_entry(gray) + offset;
+                const value_type *source = table_entry(previous) + offset;
+
+                std::copy(source, source + length, entry);
+
+                SuperCoder::subtract(
+                    entry,
+                    SuperCoder::symbol_value(m_group_begin + bit) + offset,
+                    length);
+
+                previous = gray;
+            }
+
+            for(uint32_t k = 0; k < m_eliminations.size(); ++k)
+            {
+                const row_operation &elimination = m_eliminations[k];
+
+                SuperCoder::subtract(
+                    SuperCoder::symbol_value(elimination.m_row) + offset,
+                    table_entry(elimination.m_source) + offset,
+                    length);
+            }
+        }
+
+        /// Invokes a function on stripes of the symbol data. Without a
+        /// thread pool the function is invoked once for the whole
+        /// symbol, otherwise the symbol is split into one stripe per
+        /// thread with each stripe a multiple of 16 bytes.
+        /// @param function The member function to invoke with the offset
+        ///        and length of the stripe in elements
+        void run_striped(void (linear_block_decoder_delayed::*function)(
+                             uint32_t, uint32_t))
+        {
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            uint32_t stripes = m_thread_pool ?
+                std::min(m_thread_pool->threads(),
+                         SuperCoder::symbol_size() / min_stripe_size) : 1;
+
+            if(stripes <= 1)
+            {
+                (this->*function)(0, symbol_length);
+                return;
+            }
+
+            uint32_t alignment = buffer_alignment / sizeof(value_type);
+
+            uint32_t stripe_length = (symbol_length + stripes - 1) / stripes;
+            stripe_length = ((stripe_length + alignment - 1) / alignment) *
+                alignment;
+
+            stripes = (symbol_length + stripe_length - 1) / stripe_length;
+
+            m_thread_pool->run(stripes, [=](uint32_t stripe)
+            {
+                uint32_t offset = stripe * stripe_length;
+                uint32_t length =
+                    std::min(stripe_length, symbol_length - offset);
+
+                (this->*function)(offset, length);
+            });
+        }
+
+        /// @param index The index of the entry
+        /// @return The table entry
+        value_type* table_entry(uint32_t index)
+        {
+            assert(index < (1U << m_table_bits));
+            return reinterpret_cast<value_type*>(
+                &m_table[index * m_table_stride]);
+        }
+
+        /// @param symbols The number of symbols
+        /// @param symbol_size The size of a symbol in bytes
+        /// @return The number of pivot rows to combine in a table
+        static uint32_t table_bits(uint32_t symbols, uint32_t symbol_size)
+        {
+            uint32_t stride = padded_size(symbol_size);
+            uint32_t bits = 1;
+
+            while(bits < max_table_bits &&
+                  (2U << bits) <= symbols &&
+                  (2U << bits) * stride <= max_table_size)
+            {
+                ++bits;
+            }
+
+            return bits;
+        }
+
+    private:
+
+        /// A row operation subtracting a multiple of a source row or a
+        /// table entry from a row
+        struct row_operation
+        {
+            /// The row updated
+            uint32_t m_row;
+
+            /// The row or table entry subtracted
+            uint32_t m_source;
+
+            /// The multiplier of the source
+            value_type m_value;
+        };
+
+        /// The aligned storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
+            aligned_vector;
+
+        /// The aligned storage type for field elements
+        typedef std::vector<value_type, sak::aligned_allocator<value_type> >
+            aligned_value_vector;
+
+        /// Storage for the table of symbol combinations
+        aligned_vector m_table;
+
+        /// The number of pivot rows combined in a table
+        uint32_t m_table_bits;
+
+        /// The distance in bytes between two table entries
+        uint32_t m_table_stride;
+
+        /// The first pivot of the group being substituted
+        uint32_t m_group_begin;
+
+        /// One past the last pivot of the group being substituted
+        uint32_t m_group_end;
+
+        /// The row operations recorded for the symbol data
+        std::vector<row_operation> m_operations;
+
+        /// The table entries to subtract from the symbol data
+        std::vector<row_operation> m_eliminations;
+
+        /// Scratch space for the striped multiplications
+        aligned_value_vector m_scratch;
+
+        /// The thread pool used for the final backward substitution
+        thread_pool_pointer m_thread_pool;
+
     };
 }
 
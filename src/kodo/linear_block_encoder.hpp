@@ -6,12 +6,16 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
+#include <vector>
 
 #include <fifi/is_binary.hpp>
 #include <fifi/fifi_utils.hpp>
 
 #include <sak/storage.hpp>
 
+#include "find_nonzero.hpp"
+
 namespace kodo
 {
 
@@ -21,6 +25,22 @@ namespace kodo
     /// This type of encoder iterates
     /// over a coefficient vector and combines symbols according
     /// to the coefficients selected.
+    ///
+    /// The first term of an encoded symbol is written directly to the
+    /// symbol data buffer, as a copy or a copy multiplied in place, and
+    /// the following terms are added to it. The buffer therefore does
+    /// not have to be zeroed in advance.
+    ///
+    /// When the positions of the non-zero coefficients are known, e.g.
+    /// from a sparse generator, encode_sparse_symbol() visits only those
+    /// positions instead of scanning the coefficient vector.
+    ///
+    /// A batch of symbols can be encoded with encode_symbols() which
+    /// multiplies the coefficient matrix of the batch with the block a
+    /// tile of the symbols at a time. Each tile of a source symbol is
+    /// then read from memory once and applied to all symbols in the
+    /// batch while the corresponding tiles of the encoded symbols stay
+    /// in cache.
     template<class SuperCoder>
     class linear_block_encoder : public SuperCoder
     {
@@ -32,8 +52,24 @@ namespace kodo
         /// @copydoc layer::value_type
         typedef typename SuperCoder::value_type value_type;
 
+        /// The number of bytes of cache the tiles of a batch should fit
+        /// in, chosen to match a typical L2 cache
+        static const uint32_t batch_cache_size = 1 << 18;
+
+        /// The smallest tile size in bytes used when encoding a batch
+        static const uint32_t min_tile_size = 256;
+
     public:
 
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_batch_offsets.resize(the_factory.max_symbols() + 1, 0);
+        }
+
         /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
         void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
         {
@@ -60,38 +96,321 @@ namespace kodo
             const value_type *c =
                 reinterpret_cast<const value_type*>(coefficients);
 
-            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            uint32_t symbols = SuperCoder::symbols();
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            bool first = true;
+
+            for(uint32_t i = find_nonzero<field_type>(c, 0, symbols);
+                i < symbols;
+                i = find_nonzero<field_type>(c, i + 1, symbols))
+            {
+                value_type value = fifi::get_value<field_type>(c, i);
+
+                add_term(symbol, i, value, first);
+                first = false;
+            }
+
+            if(first)
+            {
+                std::fill_n(symbol, symbol_length, 0);
+            }
+        }
+
+        /// @copydoc layer::encode_sparse_symbol(uint8_t*, uint8_t*,
+        ///                                      const uint32_t*, uint32_t)
+        void encode_sparse_symbol(uint8_t *symbol_data, uint8_t *coefficients,
+                                  const uint32_t *positions, uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+            assert(positions != 0);
+
+            value_type *symbol =
+                reinterpret_cast<value_type*>(symbol_data);
+
+            const value_type *c =
+                reinterpret_cast<const value_type*>(coefficients);
+
+            for(uint32_t k = 0; k < count; ++k)
             {
+                uint32_t i = positions[k];
+                assert(i < SuperCoder::symbols());
+
                 value_type value = fifi::get_value<field_type>(c, i);
 
-                if(!value)
+                add_term(symbol, i, value, k == 0);
+            }
+
+            if(count == 0)
+            {
+                std::fill_n(symbol, SuperCoder::symbol_length(), 0);
+            }
+        }
+
+        /// @copydoc layer::encode_symbols(uint8_t**,uint8_t**,uint32_t)
+        void encode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            if(count == 0)
+            {
+                return;
+            }
+
+            collect_terms(coefficients, count);
+
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            // Symbols without any terms are never written by the tiles
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                if(!m_batch_written[k])
+                {
+                    value_type *symbol =
+                        reinterpret_cast<value_type*>(symbol_data[k]);
+
+                    std::fill_n(symbol, symbol_length, 0);
+                }
+            }
+
+            uint32_t tile_length = batch_tile_length(count);
+
+            for(uint32_t offset = 0; offset < symbol_length;
+                offset += tile_length)
+            {
+                uint32_t length = std::min(tile_length, symbol_length - offset);
+
+                encode_tile(symbol_data, offset, length);
+            }
+        }
+
+    protected:
+
+        /// A non-zero coefficient of a batch
+        struct batch_term
+        {
+            /// The index of the encoded symbol in the batch
+            uint32_t m_output;
+
+            /// The coefficient of the source symbol
+            value_type m_value;
+
+            /// True if this is the first term of the encoded symbol and
+            /// should overwrite it rather than be added to it
+            bool m_first;
+        };
+
+        /// Adds a single term to an encoded symbol
+        /// @param symbol The symbol data buffer
+        /// @param index The index of the source symbol
+        /// @param value The non-zero coefficient of the source symbol
+        /// @param first True if this is the first term of the symbol, in
+        ///        which case the symbol data buffer is overwritten
+        void add_term(value_type *symbol, uint32_t index, value_type value,
+                      bool first)
+        {
+            assert(value != 0);
+
+            const value_type *symbol_i = SuperCoder::symbol_value(index);
+
+            // Did you forget to set the data on the encoder?
+            assert(symbol_i != 0);
+            assert(SuperCoder::symbol_pivot(index));
+
+            uint32_t symbol_length = SuperCoder::symbol_length();
+
+            if(first)
+            {
+                write_term(symbol, symbol_i, value, symbol_length);
+            }
+            else if(fifi::is_binary<field_type>::value)
+            {
+                SuperCoder::add(symbol, symbol_i, symbol_length);
+            }
+            else
+            {
+                SuperCoder::multiply_add(
+                    symbol, symbol_i, value, symbol_length);
+            }
+        }
+
+        /// Writes a single term to a symbol data buffer, overwriting its
+        /// content. This replaces zeroing the buffer followed by adding
+        /// the term and saves a pass over the buffer.
+        /// @param symbol The symbol data buffer
+        /// @param symbol_i The source symbol
+        /// @param value The coefficient of the source symbol
+        /// @param length The number of elements to write
+        void write_term(value_type *symbol, const value_type *symbol_i,
+                        value_type value, uint32_t length)
+        {
+            assert(symbol != 0);
+            assert(symbol_i != 0);
+            assert(value != 0);
+
+            std::copy(symbol_i, symbol_i + length, symbol);
+
+            if(!fifi::is_binary<field_type>::value && value != 1)
+            {
+                SuperCoder::multiply(symbol, value, length);
+            }
+        }
+
+        /// Collects the non-zero coefficients of a batch grouped by the
+        /// source symbol they apply to
+        /// @param coefficients The coefficients of the batch
+        /// @param count The number of symbols in the batch
+        void collect_terms(uint8_t **coefficients, uint32_t count)
+        {
+            uint32_t symbols = SuperCoder::symbols();
+
+            // Count the terms per source symbol
+            std::fill_n(m_batch_offsets.begin(), symbols + 1, 0);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(coefficients[k] != 0);
+
+                const value_type *c =
+                    reinterpret_cast<const value_type*>(coefficients[k]);
+
+                for(uint32_t i = find_nonzero<field_type>(c, 0, symbols);
+                    i < symbols;
+                    i = find_nonzero<field_type>(c, i + 1, symbols))
+                {
+                    ++m_batch_offsets[i + 1];
+                }
+            }
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                m_batch_offsets[i + 1] += m_batch_offsets[i];
+            }
+
+            m_batch_terms.resize(m_batch_offsets[symbols]);
+            m_batch_written.assign(count, false);
+
+            // Fill in the terms, the offsets are used as insertion
+            // points and restored afterwards
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                const value_type *c =
+                    reinterpret_cast<const value_type*>(coefficients[k]);
+
+                for(uint32_t i = find_nonzero<field_type>(c, 0, symbols);
+                    i < symbols;
+                    i = find_nonzero<field_type>(c, i + 1, symbols))
+                {
+                    // The tiles apply the terms in source symbol order
+                    // so the lowest source symbol comes first
+                    batch_term term =
+                        { k, fifi::get_value<field_type>(c, i),
+                          !m_batch_written[k] };
+
+                    m_batch_written[k] = true;
+
+                    m_batch_terms[m_batch_offsets[i]++] = term;
+                }
+            }
+
+            for(uint32_t i = symbols; i > 0; --i)
+            {
+                m_batch_offsets[i] = m_batch_offsets[i - 1];
+            }
+
+            m_batch_offsets[0] = 0;
+        }
+
+        /// Encodes one tile of every symbol in the batch
+        /// @param symbol_data The encoded symbols of the batch
+        /// @param offset The first element of the tile
+        /// @param length The number of elements in the tile
+        void encode_tile(uint8_t **symbol_data, uint32_t offset,
+                         uint32_t length)
+        {
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                uint32_t begin = m_batch_offsets[i];
+                uint32_t end = m_batch_offsets[i + 1];
+
+                if(begin == end)
                 {
                     continue;
                 }
 
                 const value_type *symbol_i =
-                    SuperCoder::symbol_value( i );
+                    SuperCoder::symbol_value(i) + offset;
 
                 // Did you forget to set the data on the encoder?
-                assert(symbol_i != 0);
+                assert(SuperCoder::symbol_value(i) != 0);
                 assert(SuperCoder::symbol_pivot(i));
 
-                if(fifi::is_binary<field_type>::value)
-                {
-                    SuperCoder::add(symbol, symbol_i,
-                                    SuperCoder::symbol_length());
-                }
-                else
+                for(uint32_t t = begin; t < end; ++t)
                 {
-                    SuperCoder::multiply_add(
-                        symbol, symbol_i, value,
-                        SuperCoder::symbol_length());
+                    const batch_term &term = m_batch_terms[t];
+
+                    value_type *symbol = reinterpret_cast<value_type*>(
+                        symbol_data[term.m_output]) + offset;
+
+                    if(term.m_first)
+                    {
+                        write_term(symbol, symbol_i, term.m_value, length);
+                    }
+                    else if(fifi::is_binary<field_type>::value)
+                    {
+                        SuperCoder::add(symbol, symbol_i, length);
+                    }
+                    else
+                    {
+                        SuperCoder::multiply_add(
+                            symbol, symbol_i, term.m_value, length);
+                    }
                 }
             }
         }
 
+        /// @param count The number of symbols in the batch
+        /// @return The tile length in elements such that a tile of every
+        ///         symbol in the batch and of a source symbol fit in the
+        ///         cache
+        uint32_t batch_tile_length(uint32_t count) const
+        {
+            uint32_t tile_size = batch_cache_size / (count + 1);
+
+            // Keep the tiles 16 byte aligned
+            tile_size = std::max(min_tile_size, tile_size - tile_size % 16);
+
+            uint32_t tile_length =
+                fifi::size_to_length<field_type>(tile_size);
+
+            return std::min(tile_length, SuperCoder::symbol_length());
+        }
+
+    private:
+
+        /// The first term of every source symbol in m_batch_terms, with
+        /// one extra entry marking the end of the terms
+        std::vector<uint32_t> m_batch_offsets;
+
+        /// The non-zero coefficients of the batch
+        std::vector<batch_term> m_batch_terms;
+
+        /// Whether each encoded symbol of the batch has any terms
+        std::vector<bool> m_batch_written;
+
     };
 
+    template<class SuperCoder>
+    const uint32_t linear_block_encoder<SuperCoder>::batch_cache_size;
+
+    template<class SuperCoder>
+    const uint32_t linear_block_encoder<SuperCoder>::min_tile_size;
+
 }
 
 
@@ -0,0 +1,60 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "object_encoder.hpp"
+#include "mapped_file_reader.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+
+namespace kodo
+{
+
+    /// @brief A mapped file encoder creates a number of encoders
+    ///        over the data of a memory mapped file.
+    ///
+    /// Works like the file_encoder but the encoders use the mapped
+    /// pages of the file directly, see the mapped_file_reader. The
+    /// encoders must use the partial_shallow_symbol_storage. Only
+    /// available with the POSIX file API, see posix_file_api.hpp.
+    template
+    <
+        class EncoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class mapped_file_encoder : public
+            object_encoder
+            <
+                mapped_file_reader<EncoderType>,
+                EncoderType,
+                BlockPartitioning
+            >
+    {
+    public:
+
+        /// The encoder factory type
+        typedef typename EncoderType::factory factory;
+
+    public:
+
+        /// Constructs a new object encoder. The kernel is advised to read
+        /// one block ahead of the block used by the last encoder built.
+        /// @param factory the encoder factory to use
+        /// @param filename the file to encode, std::system_error is
+        ///        thrown if it cannot be mapped
+        mapped_file_encoder(typename EncoderType::factory &factory,
+                            const std::string &filename)
+            : object_encoder
+                  <
+                  mapped_file_reader<EncoderType>,
+                  EncoderType,
+                  BlockPartitioning
+                  >
+              (factory, mapped_file_reader<EncoderType>(
+                  filename,
+                  factory.max_symbols() * factory.max_symbol_size()))
+            { }
+    };
+}
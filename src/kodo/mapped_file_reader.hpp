@@ -0,0 +1,237 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "posix_file_api.hpp"
+
+#if !defined(KODO_POSIX_FILE_API)
+    #error "The mapped_file_reader requires the POSIX file API"
+#endif
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <sak/storage.hpp>
+
+#include "has_shallow_symbol_storage.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup object_data_implementation
+    ///
+    /// @brief The mapped file reader maps a local file into memory and
+    ///        initializes encoders with pointers straight into the
+    ///        mapped pages. This class can be used in conjunction with
+    ///        object encoders.
+    ///
+    /// Unlike the file_reader no data is copied, the encoders must
+    /// therefore use const shallow symbol storage. The last block of a
+    /// file is usually smaller than the encoder block, in which case
+    /// the encoder must use the partial_shallow_symbol_storage which
+    /// zero pads the final partial symbol. When a block is read the
+    /// kernel is advised that the following blocks will be needed soon.
+    ///
+    /// The mapping is released when the reader and all copies of it
+    /// are destroyed, the encoders must not be used after that.
+    ///
+    /// The reader uses the POSIX mmap API, see posix_file_api.hpp.
+    /// A std::system_error is thrown if the file cannot be mapped,
+    /// which includes empty files.
+    template<class EncoderType>
+    class mapped_file_reader
+    {
+    public:
+
+        static_assert(has_const_shallow_symbol_storage<EncoderType>::value,
+                      "Mapped file reader only works with encoders using "
+                      "const shallow storage");
+
+    public:
+
+        /// Pointer to the encoders
+        typedef typename EncoderType::pointer pointer;
+
+    public:
+
+        /// Construct a new mapped file reader
+        /// @param filename of the file to use
+        /// @param read_ahead the number of bytes following a block read
+        ///        which the kernel is advised to read in advance
+        mapped_file_reader(const std::string &filename, uint32_t read_ahead)
+            : m_mapping(boost::make_shared<mapping>(filename)),
+              m_read_ahead(read_ahead)
+        { }
+
+        /// @return the size in bytes of the file
+        uint64_t size() const
+        {
+            return m_mapping->m_size;
+        }
+
+        /// Initializes the encoder with data from the file.
+        /// @param encoder to be initialized
+        /// @param offset in bytes into the storage object
+        /// @param size the number of bytes to use
+        void read(pointer &encoder, uint64_t offset, uint32_t size)
+        {
+            assert(encoder);
+            assert(offset < m_mapping->m_size);
+            assert(size > 0);
+
+            uint64_t remaining_bytes = m_mapping->m_size - offset;
+            assert(size <= remaining_bytes);
+
+            encoder->set_symbols(
+                sak::storage(m_mapping->m_data + offset, size));
+
+            // We require that encoders includes the has_bytes_used
+            // layer to support partially filled encoders
+            encoder->set_bytes_used(size);
+
+            advise_read_ahead(offset + size);
+        }
+
+    private:
+
+        /// Advises the kernel that the data following a block will be
+        /// read soon
+        /// @param offset The offset in bytes of the data
+        void advise_read_ahead(uint64_t offset)
+        {
+            if(m_read_ahead == 0 || offset >= m_mapping->m_size)
+            {
+                return;
+            }
+
+            // The address passed to madvise() must be page aligned
+            uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            uint64_t begin = offset - (offset % page_size);
+
+            uint64_t length =
+                std::min<uint64_t>(m_read_ahead, m_mapping->m_size - offset) +
+                (offset - begin);
+
+            // The advice is only a hint, so failures are ignored
+            int result = madvise(
+                const_cast<uint8_t*>(m_mapping->m_data + begin), length,
+                MADV_WILLNEED);
+            (void) result;
+        }
+
+    private:
+
+        /// Read only mapping of a file shared by the copies of the reader
+        class mapping : boost::noncopyable
+        {
+        public:
+
+            /// Maps the file, throws std::system_error if the file
+            /// cannot be opened or mapped
+            /// @param filename of the file to map
+            mapping(const std::string &filename)
+                : m_data(0),
+                  m_size(0)
+            {
+                int fd = open(filename.c_str(), O_RDONLY);
+
+                if(fd < 0)
+                {
+                    throw_error(errno, "failed to open " + filename);
+                }
+
+                struct stat status;
+
+                if(fstat(fd, &status) != 0)
+                {
+                    int error = errno;
+                    close(fd);
+                    throw_error(error, "failed to stat " + filename);
+                }
+
+                // An empty file cannot be mapped
+                if(status.st_size <= 0)
+                {
+                    close(fd);
+                    throw_error(EINVAL, "cannot map empty file " + filename);
+                }
+
+                // The whole file must fit in the address space
+                if(static_cast<uint64_t>(status.st_size) > SIZE_MAX)
+                {
+                    close(fd);
+                    throw_error(EFBIG, "cannot map large file " + filename);
+                }
+
+                m_size = static_cast<uint64_t>(status.st_size);
+
+                void *data = mmap(0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                // The mapping stays valid after the file is closed
+                int error = errno;
+                close(fd);
+
+                if(data == MAP_FAILED)
+                {
+                    throw_error(error, "failed to map " + filename);
+                }
+
+                m_data = static_cast<const uint8_t*>(data);
+
+                // The blocks are mostly read in order
+                madvise(const_cast<uint8_t*>(m_data), m_size,
+                        MADV_SEQUENTIAL);
+            }
+
+            /// Unmaps the file
+            ~mapping()
+            {
+                munmap(const_cast<uint8_t*>(m_data), m_size);
+            }
+
+            /// Throws a std::system_error
+            /// @param error The errno value of the failure
+            /// @param what The description of the failure
+            static void throw_error(int error, const std::string &what)
+            {
+                throw std::system_error(
+                    error, std::generic_category(), what);
+            }
+
+        public:
+
+            /// The mapped file
+            const uint8_t *m_data;
+
+            /// The size of the file in bytes
+            uint64_t m_size;
+
+        };
+
+    private:
+
+        /// The mapped file
+        boost::shared_ptr<mapping> m_mapping;
+
+        /// The number of bytes to read ahead of a block
+        uint32_t m_read_ahead;
+
+    };
+
+}
@@ -0,0 +1,99 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+namespace kodo
+{
+
+    /// @brief Random generator policy for the coefficient generators
+    ///        based on the boost::random::mt19937 generator.
+    ///
+    /// The bytes are drawn one at a time, which produces the same
+    /// coefficients as earlier releases for a given seed. A generator
+    /// policy models the boost UniformRandomNumberGenerator concept so
+    /// it can be used with the boost distributions and in addition
+    /// provides seed() and fill().
+    ///
+    /// @see xoshiro256_generator_policy
+    class mt19937_generator_policy
+    {
+    public:
+
+        /// The random generator used
+        typedef boost::random::mt19937 generator_type;
+
+        /// The type of the values produced
+        typedef generator_type::result_type result_type;
+
+        /// The type of the seed
+        typedef generator_type::result_type seed_type;
+
+        /// The version of the seeds written by the seed codes using
+        /// this policy, see seed_symbol_id
+        static const uint8_t seed_version = 0;
+
+    public:
+
+        /// Constructor
+        mt19937_generator_policy()
+            : m_distribution()
+        { }
+
+        /// Seeds the generator
+        /// @param seed_value The seed
+        void seed(seed_type seed_value)
+        {
+            m_generator.seed(seed_value);
+        }
+
+        /// Fills a buffer with uniformly distributed random bytes
+        /// @param data The buffer
+        /// @param size The size of the buffer in bytes
+        void fill(uint8_t *data, uint32_t size)
+        {
+            assert(data != 0);
+
+            for(uint32_t i = 0; i < size; ++i)
+            {
+                data[i] = m_distribution(m_generator);
+            }
+        }
+
+        /// @return The next random value
+        result_type operator()()
+        {
+            return m_generator();
+        }
+
+        /// @return The smallest value produced
+        static result_type min()
+        {
+            return generator_type::min();
+        }
+
+        /// @return The largest value produced
+        static result_type max()
+        {
+            return generator_type::max();
+        }
+
+    private:
+
+        /// Distribution that generates random bytes
+        boost::random::uniform_int_distribution<uint8_t> m_distribution;
+
+        /// The random generator
+        generator_type m_generator;
+
+    };
+
+}
@@ -7,7 +7,6 @@
 
 #include "../payload_encoder.hpp"
 #include "../payload_decoder.hpp"
-#include "../zero_symbol_encoder.hpp"
 #include "../linear_block_encoder.hpp"
 #include "../forward_linear_block_decoder.hpp"
 #include "../deep_symbol_storage.hpp"
@@ -45,7 +45,7 @@ namespace kodo
         /// Constructs a new object decoder
         /// @param factory The decoder factory to use
         /// @param object_size The size in bytes of the object to be decoded
-        object_decoder(factory &decoder_factory, uint32_t object_size)
+        object_decoder(factory &decoder_factory, uint64_t object_size)
             : m_factory(decoder_factory),
               m_object_size(object_size)
         {
@@ -93,7 +93,7 @@ namespace kodo
         }
 
         /// @return The total size of the object to decode in bytes
-        uint32_t object_size() const
+        uint64_t object_size() const
         {
             return m_object_size;
         }
@@ -107,7 +107,7 @@ namespace kodo
         block_partitioning m_partitioning;
 
         /// Store the total object size in bytes
-        uint32_t m_object_size;
+        uint64_t m_object_size;
     };
 
 }
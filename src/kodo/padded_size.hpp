@@ -0,0 +1,27 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+namespace kodo
+{
+
+    /// The alignment in bytes of the rows of the buffers used by the
+    /// coders, matching the alignment of the aligned_coefficients_buffer
+    const uint32_t buffer_alignment = 16;
+
+    /// Used to lay out several vectors in one aligned buffer, padding
+    /// the size of every vector keeps the following one aligned.
+    /// @param size A size in bytes
+    /// @return The size rounded up to a multiple of buffer_alignment
+    inline uint32_t padded_size(uint32_t size)
+    {
+        return ((size + buffer_alignment - 1) / buffer_alignment) *
+            buffer_alignment;
+    }
+
+}
@@ -0,0 +1,516 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <sak/storage.hpp>
+
+#include "has_shallow_symbol_storage.hpp"
+#include "rfc5052_partitioning_scheme.hpp"
+#include "thread_pool.hpp"
+
+namespace kodo
+{
+
+    /// @brief The parallel object decoder decodes the blocks of an
+    ///        object concurrently on the threads of a thread pool.
+    ///
+    /// Received payloads are added with push() which stores them in the
+    /// queue of their block, push() may be called from several threads.
+    /// A call to run() decodes the queued payloads on the threads of the
+    /// pool. A block with queued payloads is scheduled on the work queue
+    /// of one thread at a time, threads without work steal blocks from
+    /// the other work queues. Only the thread holding a block touches
+    /// its decoder, so the decoders need no synchronization.
+    ///
+    /// The decoders decode directly into one buffer covering the entire
+    /// object. The blocks occupy disjoint parts of the buffer, so the
+    /// threads write to it without locking. The decoder of a block is
+    /// built when its first payload is decoded and released when the
+    /// block is complete. Building and releasing decoders is serialized,
+    /// since the factory is not thread-safe.
+    template
+    <
+        class DecoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class parallel_object_decoder : boost::noncopyable
+    {
+    public:
+
+        /// The decoders decode directly into the object buffer
+        static_assert(
+            has_mutable_shallow_symbol_storage<DecoderType>::value,
+            "Parallel object decoder only works with decoders using "
+            "shallow storage");
+
+        /// The type of factory used to build decoders
+        typedef typename DecoderType::factory factory;
+
+        /// Pointer to a decoder
+        typedef typename DecoderType::pointer pointer;
+
+        /// The block partitioning scheme used
+        typedef BlockPartitioning block_partitioning;
+
+        /// Pointer to the thread pool
+        typedef boost::shared_ptr<thread_pool> thread_pool_pointer;
+
+        /// The block complete callback. The callback is invoked from
+        /// the thread completing the block with the block id.
+        typedef std::function<void (uint32_t)> block_complete_callback;
+
+        /// The object complete callback. The callback is invoked from
+        /// the thread completing the last block.
+        typedef std::function<void ()> object_complete_callback;
+
+    public:
+
+        /// Constructs a new parallel object decoder
+        /// @param decoder_factory The decoder factory to use, it must not
+        ///        be used elsewhere while the object is decoded
+        /// @param object_size The size in bytes of the object to decode
+        /// @param pool The thread pool used to decode the blocks
+        parallel_object_decoder(factory &decoder_factory,
+                                uint64_t object_size,
+                                const thread_pool_pointer &pool)
+            : m_factory(decoder_factory),
+              m_object_size(object_size),
+              m_thread_pool(pool),
+              m_blocks_complete(0)
+        {
+            assert(m_object_size > 0);
+            assert(m_thread_pool);
+
+            m_partitioning = block_partitioning(
+                m_factory.max_symbols(),
+                m_factory.max_symbol_size(),
+                m_object_size);
+
+            m_payload_size = m_factory.max_payload_size();
+
+            m_decoding_storage.resize(
+                m_partitioning.total_block_size(), '\0');
+
+            for(uint32_t i = 0; i < m_partitioning.blocks(); ++i)
+            {
+                m_blocks.push_back(boost::make_shared<block_state>());
+            }
+
+            for(uint32_t i = 0; i < m_thread_pool->threads(); ++i)
+            {
+                m_work.push_back(boost::make_shared<work_queue>());
+            }
+        }
+
+        /// @return The number of decoders needed for this object
+        uint32_t decoders() const
+        {
+            return m_partitioning.blocks();
+        }
+
+        /// @return The number of threads decoding the blocks
+        uint32_t threads() const
+        {
+            return m_thread_pool->threads();
+        }
+
+        /// @return The total size of the object to decode in bytes
+        uint64_t object_size() const
+        {
+            return m_object_size;
+        }
+
+        /// Sets the function invoked when a block is complete
+        /// @param callback The block complete callback
+        void set_block_complete_callback(
+            const block_complete_callback &callback)
+        {
+            assert(callback);
+            m_block_callback = callback;
+        }
+
+        /// Sets the function invoked when all blocks are complete
+        /// @param callback The object complete callback
+        void set_object_complete_callback(
+            const object_complete_callback &callback)
+        {
+            assert(callback);
+            m_object_callback = callback;
+        }
+
+        /// Queues a payload for decoding by the next run(). May be called
+        /// from several threads, also while run() is in progress.
+        /// Payloads of complete blocks are dropped.
+        /// @param decoder_id The block the payload belongs to
+        /// @param payload The payload, which is copied
+        /// @param size The size of the payload in bytes
+        /// @return True if the payload was queued
+        bool push(uint32_t decoder_id, const uint8_t *payload, uint32_t size)
+        {
+            assert(decoder_id < m_blocks.size());
+            assert(payload != 0);
+            assert(size > 0);
+            assert(size <= m_payload_size);
+
+            block_state &block = *m_blocks[decoder_id];
+
+            bool schedule = false;
+
+            {
+                std::lock_guard<std::mutex> lock(block.m_mutex);
+
+                if(block.m_complete)
+                {
+                    return false;
+                }
+
+                block.m_pending.resize(
+                    (block.m_pending_count + 1) * m_payload_size);
+
+                std::copy(payload, payload + size,
+                    &block.m_pending[block.m_pending_count * m_payload_size]);
+
+                ++block.m_pending_count;
+
+                schedule = !block.m_scheduled;
+                block.m_scheduled = true;
+            }
+
+            if(schedule)
+            {
+                work_queue &queue = *m_work[decoder_id % m_work.size()];
+
+                std::lock_guard<std::mutex> lock(queue.m_mutex);
+                queue.m_blocks.push_back(decoder_id);
+            }
+
+            return true;
+        }
+
+        /// Decodes the queued payloads on the threads of the pool and
+        /// returns when no scheduled blocks are left. Payloads pushed
+        /// while run() is in progress may be left for the next run().
+        /// An exception thrown by a callback is rethrown once the other
+        /// threads have stopped working.
+        void run()
+        {
+            m_thread_pool->run(threads(), [&](uint32_t thread)
+                {
+                    work(thread);
+                });
+        }
+
+        /// @param decoder_id The block to check
+        /// @return True if the block has been decoded
+        bool is_block_complete(uint32_t decoder_id) const
+        {
+            assert(decoder_id < m_blocks.size());
+
+            block_state &block = *m_blocks[decoder_id];
+
+            std::lock_guard<std::mutex> lock(block.m_mutex);
+            return block.m_complete;
+        }
+
+        /// @return The number of blocks decoded
+        uint32_t blocks_complete() const
+        {
+            return m_blocks_complete;
+        }
+
+        /// @return True if all blocks have been decoded
+        bool is_complete() const
+        {
+            return m_blocks_complete == m_partitioning.blocks();
+        }
+
+        /// Returns the decoded data, this should not be called until all
+        /// blocks have completed.
+        ///
+        /// @return A pointer to the decoded data
+        const uint8_t* data() const
+        {
+            return &m_decoding_storage[0];
+        }
+
+        /// If you wish to take ownership of the decoded data you may
+        /// use the swap function to get the std::vector. This should not
+        /// be called until all blocks have completed.
+        ///
+        /// @param decoding_storage The vector to swap with the internal
+        ///        vector
+        void swap(std::vector<uint8_t> &decoding_storage)
+        {
+            // Resize the storage buffer to have the object size
+            m_decoding_storage.resize(m_object_size);
+            m_decoding_storage.swap(decoding_storage);
+        }
+
+    private:
+
+        /// The state of a block
+        struct block_state
+        {
+            block_state()
+                : m_pending_count(0),
+                  m_scheduled(false),
+                  m_complete(false)
+            { }
+
+            /// Protects the queued payloads and the flags
+            std::mutex m_mutex;
+
+            /// The queued payloads, each using a slot of the maximum
+            /// payload size
+            std::vector<uint8_t> m_pending;
+
+            /// The number of queued payloads
+            uint32_t m_pending_count;
+
+            /// The payloads being decoded, only used by the thread
+            /// holding the block
+            std::vector<uint8_t> m_working;
+
+            /// The decoder, only used by the thread holding the block
+            pointer m_decoder;
+
+            /// True while the block is on a work queue or being decoded
+            bool m_scheduled;
+
+            /// True when the block has been decoded
+            bool m_complete;
+        };
+
+        /// The blocks scheduled on a thread
+        struct work_queue
+        {
+            /// Protects the queue
+            std::mutex m_mutex;
+
+            /// The scheduled blocks, the owning thread takes blocks from
+            /// the front and other threads steal from the back
+            std::deque<uint32_t> m_blocks;
+        };
+
+    private:
+
+        /// Decodes scheduled blocks until no work queue has any left
+        /// @param thread The index of the work queue of the thread
+        void work(uint32_t thread)
+        {
+            uint32_t decoder_id = 0;
+
+            while(take(thread, decoder_id))
+            {
+                decode_block(decoder_id);
+            }
+        }
+
+        /// Takes a block from the work queue of the thread or steals one
+        /// from the other work queues
+        /// @param thread The index of the work queue of the thread
+        /// @param decoder_id Set to the block taken
+        /// @return True if a block was taken
+        bool take(uint32_t thread, uint32_t &decoder_id)
+        {
+            uint32_t queues = static_cast<uint32_t>(m_work.size());
+
+            for(uint32_t i = 0; i < queues; ++i)
+            {
+                work_queue &queue = *m_work[(thread + i) % queues];
+
+                std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+                if(queue.m_blocks.empty())
+                {
+                    continue;
+                }
+
+                if(i == 0)
+                {
+                    decoder_id = queue.m_blocks.front();
+                    queue.m_blocks.pop_front();
+                }
+                else
+                {
+                    decoder_id = queue.m_blocks.back();
+                    queue.m_blocks.pop_back();
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        /// Decodes the queued payloads of a block until none are left.
+        /// The calling thread holds the block until it is unscheduled.
+        /// @param decoder_id The block to decode
+        void decode_block(uint32_t decoder_id)
+        {
+            block_state &block = *m_blocks[decoder_id];
+
+            while(true)
+            {
+                uint32_t count = 0;
+
+                {
+                    std::lock_guard<std::mutex> lock(block.m_mutex);
+
+                    if(block.m_pending_count == 0)
+                    {
+                        block.m_scheduled = false;
+                        return;
+                    }
+
+                    block.m_pending.swap(block.m_working);
+                    block.m_pending.clear();
+
+                    count = block.m_pending_count;
+                    block.m_pending_count = 0;
+                }
+
+                if(!block.m_decoder)
+                {
+                    block.m_decoder = build(decoder_id);
+                }
+
+                for(uint32_t i = 0; i < count; ++i)
+                {
+                    block.m_decoder->decode(
+                        &block.m_working[i * m_payload_size]);
+
+                    if(block.m_decoder->is_complete())
+                    {
+                        complete_block(decoder_id);
+                        return;
+                    }
+                }
+            }
+        }
+
+        /// Marks a block complete, drops its queued payloads and
+        /// releases its decoder
+        /// @param decoder_id The complete block
+        void complete_block(uint32_t decoder_id)
+        {
+            block_state &block = *m_blocks[decoder_id];
+
+            {
+                std::lock_guard<std::mutex> lock(block.m_mutex);
+
+                block.m_complete = true;
+                block.m_scheduled = false;
+                block.m_pending_count = 0;
+
+                std::vector<uint8_t>().swap(block.m_pending);
+            }
+
+            std::vector<uint8_t>().swap(block.m_working);
+
+            {
+                // Return the decoder to the factory pool
+                std::lock_guard<std::mutex> lock(m_factory_mutex);
+                block.m_decoder.reset();
+            }
+
+            // Counted before the callbacks, so the block is accounted for
+            // even if a callback throws
+            uint32_t complete = ++m_blocks_complete;
+
+            if(m_block_callback)
+            {
+                m_block_callback(decoder_id);
+            }
+
+            if(complete == m_partitioning.blocks() && m_object_callback)
+            {
+                m_object_callback();
+            }
+        }
+
+        /// Builds a decoder decoding into the part of the object buffer
+        /// covered by a block
+        /// @param decoder_id Specifies the decoder to build
+        /// @return The initialized decoder
+        pointer build(uint32_t decoder_id)
+        {
+            assert(decoder_id < m_partitioning.blocks());
+
+            uint64_t offset = m_partitioning.byte_offset(decoder_id);
+            uint32_t block_size = m_partitioning.block_size(decoder_id);
+
+            sak::mutable_storage data = sak::storage(
+                &m_decoding_storage[offset], block_size);
+
+            std::lock_guard<std::mutex> lock(m_factory_mutex);
+
+            m_factory.set_symbols(m_partitioning.symbols(decoder_id));
+            m_factory.set_symbol_size(
+                m_partitioning.symbol_size(decoder_id));
+
+            pointer decoder = m_factory.build();
+
+            decoder->set_bytes_used(m_partitioning.bytes_used(decoder_id));
+            decoder->set_symbols(data);
+
+            return decoder;
+        }
+
+    private:
+
+        /// The decoder factory
+        factory &m_factory;
+
+        /// Serializes the use of the factory
+        std::mutex m_factory_mutex;
+
+        /// The block partitioning scheme used
+        block_partitioning m_partitioning;
+
+        /// Store the total object size in bytes
+        uint64_t m_object_size;
+
+        /// The size of a payload slot in the block queues
+        uint32_t m_payload_size;
+
+        /// The thread pool decoding the blocks
+        thread_pool_pointer m_thread_pool;
+
+        /// The state of every block
+        std::vector<boost::shared_ptr<block_state> > m_blocks;
+
+        /// One work queue per thread
+        std::vector<boost::shared_ptr<work_queue> > m_work;
+
+        /// The number of blocks decoded
+        std::atomic<uint32_t> m_blocks_complete;
+
+        /// Invoked when a block is complete
+        block_complete_callback m_block_callback;
+
+        /// Invoked when all blocks are complete
+        object_complete_callback m_object_callback;
+
+        /// The storage where the decoded data is placed
+        std::vector<uint8_t> m_decoding_storage;
+
+    };
+
+}
@@ -0,0 +1,219 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "rfc5052_partitioning_scheme.hpp"
+#include "thread_pool.hpp"
+
+namespace kodo
+{
+
+    /// @brief The parallel object encoder encodes the blocks of an
+    ///        object concurrently on the threads of a thread pool.
+    ///
+    /// The object_encoder reconfigures its factory before building each
+    /// encoder and can therefore only be used from one thread. The
+    /// parallel object encoder instead owns one factory per thread of
+    /// the pool. Every thread repeatedly claims the next block not yet
+    /// encoded, builds and fills an encoder for it using its own factory
+    /// and passes the coded payloads of the block to the payload
+    /// function. The encoder is released before the thread claims its
+    /// next block, so each factory recycles its encoders through its
+    /// pool.
+    ///
+    /// The object data is read from several threads at once and must
+    /// therefore support concurrent calls to read(), which is the case
+    /// for the storage_reader and the mapped_file_reader but not for the
+    /// file_reader.
+    ///
+    /// @tparam ObjectData object_data
+    /// @tparam EncoderType An encoder stack which should be used
+    /// @tparam BlockParitioning block_partitioning
+    template
+    <
+        class ObjectData,
+        class EncoderType,
+        class BlockPartitioning = rfc5052_partitioning_scheme
+    >
+    class parallel_object_encoder : boost::noncopyable
+    {
+    public:
+
+        /// The type of factory used to build encoders
+        typedef typename EncoderType::factory factory_type;
+
+        /// Pointer to an encoder
+        typedef typename EncoderType::pointer pointer_type;
+
+        /// The block partitioning scheme used
+        typedef BlockPartitioning block_partitioning;
+
+        /// The data source type
+        typedef ObjectData object_data;
+
+        /// Pointer to the thread pool
+        typedef boost::shared_ptr<thread_pool> thread_pool_pointer;
+
+        /// The function receiving the coded payloads. It is invoked
+        /// concurrently from the threads of the pool with the block id,
+        /// the payload and the size of the payload in bytes. The payload
+        /// is only valid during the call.
+        typedef std::function<
+            void (uint32_t, const uint8_t*, uint32_t)> payload_function;
+
+    public:
+
+        /// Constructs a new parallel object encoder
+        /// @param max_symbols The maximum number of symbols in a block
+        /// @param max_symbol_size The maximum size of a symbol in bytes
+        /// @param data The object to encode
+        /// @param pool The thread pool used to encode the blocks, one
+        ///        factory is created for each of its threads
+        parallel_object_encoder(uint32_t max_symbols,
+                                uint32_t max_symbol_size,
+                                const object_data &data,
+                                const thread_pool_pointer &pool) :
+            m_data(data),
+            m_thread_pool(pool),
+            m_next(0)
+        {
+            assert(m_data.size() > 0);
+            assert(m_thread_pool);
+
+            for(uint32_t i = 0; i < m_thread_pool->threads(); ++i)
+            {
+                m_factories.push_back(boost::make_shared<factory_type>(
+                    max_symbols, max_symbol_size));
+            }
+
+            m_payloads.resize(m_thread_pool->threads());
+
+            m_partitioning = block_partitioning(
+                max_symbols, max_symbol_size, m_data.size());
+        }
+
+        /// @return The number of encoders needed for this object
+        uint32_t encoders() const
+        {
+            return m_partitioning.blocks();
+        }
+
+        /// @return The number of threads encoding the blocks
+        uint32_t threads() const
+        {
+            return m_thread_pool->threads();
+        }
+
+        /// Encodes all blocks of the object and returns when every
+        /// payload has been passed to the payload function. An exception
+        /// thrown by the payload function is rethrown once the other
+        /// threads have finished their blocks.
+        /// @param payloads The number of coded payloads produced for
+        ///        every block
+        /// @param sink The function receiving the payloads
+        void encode(uint32_t payloads, const payload_function &sink)
+        {
+            assert(sink);
+
+            m_next = 0;
+
+            m_thread_pool->run(threads(), [&](uint32_t thread)
+                {
+                    encode_blocks(thread, payloads, sink);
+                });
+        }
+
+        /// @return The total size of the object to encode in bytes
+        uint64_t object_size() const
+        {
+            return m_data.size();
+        }
+
+    private:
+
+        /// Encodes blocks until all blocks have been claimed. Each
+        /// thread index is used by one thread at a time, so the factory
+        /// and payload buffer of the index are not shared.
+        /// @param thread The index of the factory to use
+        /// @param payloads The number of payloads produced per block
+        /// @param sink The function receiving the payloads
+        void encode_blocks(uint32_t thread, uint32_t payloads,
+                           const payload_function &sink)
+        {
+            assert(thread < m_factories.size());
+
+            factory_type &factory = *m_factories[thread];
+            std::vector<uint8_t> &payload = m_payloads[thread];
+
+            uint32_t blocks = m_partitioning.blocks();
+
+            for(uint32_t block = m_next++; block < blocks; block = m_next++)
+            {
+                pointer_type encoder = build(factory, block);
+
+                payload.resize(encoder->payload_size());
+
+                for(uint32_t i = 0; i < payloads; ++i)
+                {
+                    uint32_t size = encoder->encode(&payload[0]);
+                    sink(block, &payload[0], size);
+                }
+            }
+        }
+
+        /// Builds and initializes the encoder of a block
+        /// @param factory The factory of the calling thread
+        /// @param encoder_id Specifies the encoder to build
+        /// @return The initialized encoder
+        pointer_type build(factory_type &factory, uint32_t encoder_id)
+        {
+            assert(encoder_id < m_partitioning.blocks());
+
+            factory.set_symbols(m_partitioning.symbols(encoder_id));
+            factory.set_symbol_size(m_partitioning.symbol_size(encoder_id));
+
+            pointer_type encoder = factory.build();
+
+            uint64_t offset = m_partitioning.byte_offset(encoder_id);
+            uint32_t bytes_used = m_partitioning.bytes_used(encoder_id);
+
+            m_data.read(encoder, offset, bytes_used);
+
+            return encoder;
+        }
+
+    private:
+
+        /// Store the object storage
+        object_data m_data;
+
+        /// The block partitioning scheme used
+        block_partitioning m_partitioning;
+
+        /// The thread pool encoding the blocks
+        thread_pool_pointer m_thread_pool;
+
+        /// One encoder factory per thread
+        std::vector<boost::shared_ptr<factory_type> > m_factories;
+
+        /// One payload buffer per thread
+        std::vector<std::vector<uint8_t> > m_payloads;
+
+        /// The next block to be encoded
+        std::atomic<uint32_t> m_next;
+    };
+
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 namespace kodo
 {
@@ -53,12 +54,45 @@ namespace kodo
             SuperCoder::decode(symbol_data, symbol_id);
         }
 
+        /// Unpacks the symbol data and symbol header from every payload
+        /// buffer in the batch.
+        /// @copydoc layer::decode_batch(uint8_t**,uint32_t)
+        void decode_batch(uint8_t **payloads, uint32_t count)
+        {
+            assert(payloads != 0);
+
+            m_symbol_data.resize(count);
+            m_symbol_header.resize(count);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(payloads[k] != 0);
+
+                m_symbol_data[k] = payloads[k];
+                m_symbol_header[k] = payloads[k] + SuperCoder::symbol_size();
+            }
+
+            if(count > 0)
+            {
+                SuperCoder::decode_batch(
+                    &m_symbol_data[0], &m_symbol_header[0], count);
+            }
+        }
+
         /// @copydoc layer::payload_size() const
         uint32_t payload_size() const
         {
             return SuperCoder::symbol_size() +
                 SuperCoder::header_size();
         }
+
+    private:
+
+        /// The symbol data of the payloads in a batch
+        std::vector<uint8_t*> m_symbol_data;
+
+        /// The symbol headers of the payloads in a batch
+        std::vector<uint8_t*> m_symbol_header;
     };
 
 }
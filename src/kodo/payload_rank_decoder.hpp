@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 #include <sak/convert_endian.hpp>
 
 namespace kodo
@@ -67,6 +68,29 @@ namespace kodo
             SuperCoder::decode(payload + read);
         }
 
+        /// Reads the encoder rank from every payload buffer in the batch
+        /// before passing the batch on.
+        /// @copydoc layer::decode_batch(uint8_t**,uint32_t)
+        void decode_batch(uint8_t** payloads, uint32_t count)
+        {
+            assert(payloads != 0);
+
+            m_payloads.resize(count);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(payloads[k] != 0);
+
+                uint32_t read = read_rank(payloads[k]);
+                m_payloads[k] = payloads[k] + read;
+            }
+
+            if(count > 0)
+            {
+                SuperCoder::decode_batch(&m_payloads[0], count);
+            }
+        }
+
         /// Reads the rank of the encoder from the payload buffer
         /// @param payload The payload buffer
         /// @return The amount of bytes read
@@ -104,6 +128,9 @@ namespace kodo
         /// Stores the read encoder rank
         rank_type m_encoder_rank;
 
+        /// The payloads of a batch with the rank removed
+        std::vector<uint8_t*> m_payloads;
+
     };
 
 }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
+
 #include <sak/convert_endian.hpp>
 
 namespace kodo
@@ -71,6 +73,38 @@ namespace kodo
             return SuperCoder::encode(payload + written) + written;
         }
 
+        /// Writes the encoder rank to every payload buffer in the batch
+        /// before passing the batch on.
+        /// @copydoc layer::encode_batch(uint8_t**,uint32_t*,uint32_t)
+        void encode_batch(uint8_t** payloads, uint32_t* bytes_used,
+                          uint32_t count)
+        {
+            assert(payloads != 0);
+            assert(bytes_used != 0);
+
+            m_payloads.resize(count);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(payloads[k] != 0);
+
+                uint32_t written = write_rank(payloads[k]);
+                m_payloads[k] = payloads[k] + written;
+            }
+
+            if(count == 0)
+            {
+                return;
+            }
+
+            SuperCoder::encode_batch(&m_payloads[0], bytes_used, count);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                bytes_used[k] += sizeof(rank_type);
+            }
+        }
+
         /// Helper function which writes the rank of the encoder into
         /// the payload buffer
         /// @param payload The buffer where the rank should be written
@@ -91,6 +125,11 @@ namespace kodo
             return SuperCoder::payload_size() + sizeof(rank_type);
         }
 
+    private:
+
+        /// The payload buffers of a batch past the rank
+        std::vector<uint8_t*> m_payloads;
+
     };
 
 }
@@ -0,0 +1,239 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "bit_scan.hpp"
+
+namespace kodo
+{
+
+    /// @brief Packed bitmap used to track the pivot positions of the
+    ///        decoding matrix.
+    ///
+    /// The bits are stored in 64 bit words with the bit for index i
+    /// stored in bit (i % 64) of word (i / 64), which allows the
+    /// decoders, generators and recoders to scan the pivots a word at a
+    /// time. The number of bits set is maintained so that count() is
+    /// constant time.
+    class pivot_bitmap
+    {
+    public:
+
+        /// The word type used for storing the bits
+        typedef uint64_t word_type;
+
+        /// The number of bits in a word
+        static const uint32_t word_bits = 64;
+
+    public:
+
+        /// Constructor
+        pivot_bitmap()
+            : m_size(0),
+              m_count(0)
+        { }
+
+        /// Allocates the storage needed for the bitmap
+        /// @param max_size The maximum number of bits in the bitmap
+        void resize(uint32_t max_size)
+        {
+            m_words.resize(word_count(max_size), 0);
+        }
+
+        /// Clears all bits and sets the number of bits in use
+        /// @param size The number of bits in the bitmap
+        void reset(uint32_t size)
+        {
+            assert(word_count(size) <= m_words.size());
+
+            std::fill_n(m_words.begin(), word_count(size), 0);
+
+            m_size = size;
+            m_count = 0;
+        }
+
+        /// @return The number of bits in the bitmap
+        uint32_t size() const
+        {
+            return m_size;
+        }
+
+        /// @return The number of bits set
+        uint32_t count() const
+        {
+            return m_count;
+        }
+
+        /// @param index The index of the bit
+        /// @return True if the bit is set
+        bool test(uint32_t index) const
+        {
+            assert(index < m_size);
+            return (m_words[index / word_bits] >> (index % word_bits)) & 0x1;
+        }
+
+        /// @copydoc test(uint32_t) const
+        bool operator[](uint32_t index) const
+        {
+            return test(index);
+        }
+
+        /// Sets a bit
+        /// @param index The index of the bit
+        void set(uint32_t index)
+        {
+            if(test(index))
+            {
+                return;
+            }
+
+            m_words[index / word_bits] |= word_type(1) << (index % word_bits);
+            ++m_count;
+        }
+
+        /// Clears a bit
+        /// @param index The index of the bit
+        void clear(uint32_t index)
+        {
+            if(!test(index))
+            {
+                return;
+            }
+
+            m_words[index / word_bits] &=
+                ~(word_type(1) << (index % word_bits));
+            --m_count;
+        }
+
+        /// @param index The index to start searching from
+        /// @return The index of the first set bit which is greater than
+        ///         or equal to index, or size() if no such bit exists
+        uint32_t find_next(uint32_t index) const
+        {
+            if(index >= m_size)
+            {
+                return m_size;
+            }
+
+            uint32_t w = index / word_bits;
+
+            // Mask off the bits below index in the first word
+            word_type word =
+                m_words[w] & (~word_type(0) << (index % word_bits));
+
+            uint32_t words = word_count(m_size);
+
+            while(word == 0)
+            {
+                if(++w == words)
+                {
+                    return m_size;
+                }
+
+                word = m_words[w];
+            }
+
+            return std::min(
+                w * word_bits + count_trailing_zeros(word), m_size);
+        }
+
+        /// @param index The index to start searching from
+        /// @return The index of the first unset bit which is greater than
+        ///         or equal to index, or size() if no such bit exists
+        uint32_t find_next_unset(uint32_t index) const
+        {
+            if(index >= m_size)
+            {
+                return m_size;
+            }
+
+            uint32_t w = index / word_bits;
+
+            word_type word =
+                ~m_words[w] & (~word_type(0) << (index % word_bits));
+
+            uint32_t words = word_count(m_size);
+
+            while(word == 0)
+            {
+                if(++w == words)
+                {
+                    return m_size;
+                }
+
+                word = ~m_words[w];
+            }
+
+            return std::min(
+                w * word_bits + count_trailing_zeros(word), m_size);
+        }
+
+        /// @return Pointer to the words storing the bits, bits at indices
+        ///         greater than or equal to size() are always zero
+        const word_type* words() const
+        {
+            assert(m_words.size() > 0);
+            return &m_words[0];
+        }
+
+        /// @param bits A number of bits
+        /// @return The number of words needed to store the bits
+        static uint32_t word_count(uint32_t bits)
+        {
+            return (bits + word_bits - 1) / word_bits;
+        }
+
+        /// Zeros all coefficients at positions where the bit is not set
+        /// in the bitmap. For the binary field this is done by combining
+        /// the bitmap and the coefficients a byte at a time.
+        /// @param coefficients The coefficient vector with size() elements
+        template<class Field>
+        void mask(typename Field::value_type *coefficients) const
+        {
+            assert(coefficients != 0);
+
+            if(fifi::is_binary<Field>::value)
+            {
+                uint32_t bytes = (m_size + 7) / 8;
+
+                for(uint32_t i = 0; i < bytes; ++i)
+                {
+                    word_type word = m_words[i / 8];
+                    coefficients[i] &= uint8_t(word >> (8 * (i % 8)));
+                }
+            }
+            else
+            {
+                for(uint32_t i = find_next_unset(0); i < m_size;
+                    i = find_next_unset(i + 1))
+                {
+                    fifi::set_value<Field>(coefficients, i, 0);
+                }
+            }
+        }
+
+    private:
+
+        /// The bits
+        std::vector<word_type> m_words;
+
+        /// The number of bits in use
+        uint32_t m_size;
+
+        /// The number of bits set
+        uint32_t m_count;
+
+    };
+
+}
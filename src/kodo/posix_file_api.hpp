@@ -0,0 +1,26 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+/// @file posix_file_api.hpp Detects whether the POSIX file API used by
+///       the mapped_file_reader and the file_decoder is available.
+///
+/// KODO_POSIX_FILE_API is defined on POSIX systems. Code using those
+/// layers, including their unit tests, should be guarded with:
+///
+/// #include <kodo/posix_file_api.hpp>
+///
+/// #if defined(KODO_POSIX_FILE_API)
+///     // Use the mapped_file_encoder or file_decoder here
+/// #endif
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+    #include <unistd.h>
+
+    #if defined(_POSIX_VERSION)
+        #define KODO_POSIX_FILE_API
+    #endif
+#endif
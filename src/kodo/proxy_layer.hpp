@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include "pivot_bitmap.hpp"
+
 namespace kodo
 {
 
@@ -462,6 +464,13 @@ namespace kodo
             return m_proxy->symbol_pivot(index);
         }
 
+        /// @copydoc layer::symbol_pivots() const
+        const pivot_bitmap& symbol_pivots() const
+        {
+            assert(m_proxy);
+            return m_proxy->symbol_pivots();
+        }
+
     protected:
 
         /// Pointer to the main stack
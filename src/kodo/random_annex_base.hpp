@@ -27,7 +27,7 @@ namespace kodo
     /// and maximum number of symbols per block is not increased.
     uint32_t max_annex_size(uint32_t max_symbols,
                             uint32_t max_symbol_size,
-                            uint32_t object_size)
+                            uint64_t object_size)
     {
         assert(max_symbols > 0);
         assert(max_symbol_size > 0);
@@ -35,7 +35,7 @@ namespace kodo
 
         // The minimum number of total symbols we can have for the given
         // maximum_symbol_size and object_size ceil(x/y) = ((x - 1) / y) + 1
-        uint32_t min_total_symbols =
+        uint64_t min_total_symbols =
             ((object_size - 1) / max_symbol_size) + 1;
 
         // Out of that we have a our maximum block size and since we
@@ -56,8 +56,9 @@ namespace kodo
             // we allow the annex to be == max_symbols the blocks could
             // end up begin pure annex in which case no blocks contain
             // actual symbols.
-            return std::min(min_total_symbols - max_symbols,
-                            max_symbols - 1);
+            return static_cast<uint32_t>(
+                std::min<uint64_t>(min_total_symbols - max_symbols,
+                                   max_symbols - 1));
         }
     }
 
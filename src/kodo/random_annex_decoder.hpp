@@ -128,7 +128,7 @@ namespace kodo
         /// @param object_size size in bytes of the object that is to
         ///        be decoded
         random_annex_decoder(uint32_t annex_size, factory_type &factory,
-                             uint32_t object_size)
+                             uint64_t object_size)
             : m_annex_size(annex_size),
               m_factory(factory),
               m_object_size(object_size)
@@ -172,7 +172,7 @@ namespace kodo
             }
 
         /// @return the total size of the object to encode in bytes
-        uint32_t object_size() const
+        uint64_t object_size() const
             {
                 return m_object_size;
             }
@@ -330,7 +330,7 @@ namespace kodo
         block_partitioning m_partitioning;
 
         /// Store the total object size in bytes
-        uint32_t m_object_size;
+        uint64_t m_object_size;
 
         /// Vector for all the decoders
         std::vector<wrap_coder> m_decoders;
@@ -104,21 +104,21 @@ namespace kodo
             }
 
         /// @return the total size of the object to encode in bytes
-        uint32_t object_size() const
+        uint64_t object_size() const
             {
                 return m_object.m_size;
             }
 
     protected:
 
-        void init_encoder(uint32_t offset, uint32_t size,
+        void init_encoder(uint64_t offset, uint32_t size,
                           pointer_type encoder) const
             {
                 assert(offset < m_object.m_size);
                 assert(size > 0);
                 assert(encoder);
 
-                uint32_t remaining_bytes = m_object.m_size - offset;
+                uint64_t remaining_bytes = m_object.m_size - offset;
 
                 assert(size <= remaining_bytes);
 
@@ -162,7 +162,7 @@ namespace kodo
                     pointer_type encoder = m_factory.build();
 
                     // Initialize encoder with data
-                    uint32_t offset =
+                    uint64_t offset =
                         m_partitioning.byte_offset(i);
 
                     uint32_t bytes_used =
@@ -12,6 +12,8 @@
 
 #include <fifi/fifi_utils.hpp>
 
+#include "pivot_bitmap.hpp"
+
 namespace kodo
 {
 
@@ -119,7 +121,14 @@ namespace kodo
             value_type *recode_coefficients
                 = reinterpret_cast<value_type*>(&m_coefficients[0]);
 
-            for(uint32_t i = 0; i < SuperCoder::symbols(); ++i)
+            // Only the symbols available in the decoder can have a
+            // non-zero recoding coefficient
+            const pivot_bitmap &pivots = SuperCoder::symbol_pivots();
+
+            uint32_t symbols = SuperCoder::symbols();
+
+            for(uint32_t i = pivots.find_next(0); i < symbols;
+                i = pivots.find_next(i + 1))
             {
                 value_type c =
                     fifi::get_value<field_type>(recode_coefficients, i);
@@ -129,8 +138,6 @@ namespace kodo
                     continue;
                 }
 
-                assert(SuperCoder::symbol_pivot(i));
-
                 const value_type *source_id =
                     SuperCoder::coefficients_value( i );
 
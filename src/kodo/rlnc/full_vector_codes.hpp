@@ -10,22 +10,26 @@
 #include <fifi/default_field.hpp>
 
 #include "../aligned_coefficients_decoder.hpp"
+#include "../batch_linear_block_decoder.hpp"
+#include "../innovation_check_decoder.hpp"
 #include "../final_coder_factory_pool.hpp"
 #include "../final_coder_factory.hpp"
 #include "../finite_field_math.hpp"
 #include "../finite_field_info.hpp"
-#include "../zero_symbol_encoder.hpp"
 #include "../systematic_encoder.hpp"
 #include "../systematic_decoder.hpp"
 #include "../storage_bytes_used.hpp"
 #include "../storage_block_info.hpp"
 #include "../deep_symbol_storage.hpp"
+#include "../partial_shallow_symbol_storage.hpp"
+#include "../shallow_symbol_storage.hpp"
 #include "../payload_encoder.hpp"
 #include "../payload_recoder.hpp"
 #include "../payload_decoder.hpp"
 #include "../symbol_id_encoder.hpp"
 #include "../symbol_id_decoder.hpp"
 #include "../coefficient_storage.hpp"
+#include "../contiguous_coefficient_storage.hpp"
 #include "../coefficient_info.hpp"
 #include "../plain_symbol_id_reader.hpp"
 #include "../plain_symbol_id_writer.hpp"
@@ -63,10 +67,9 @@ namespace kodo
                // Symbol ID API
                plain_symbol_id_writer<
                // Coefficient Generator API
-               uniform_generator<
+               fast_uniform_generator<
                // Codec API
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                storage_aware_encoder<
                // Coefficient Storage API
@@ -82,7 +85,46 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                full_rlnc_encoder<Field
-                   > > > > > > > > > > > > > > > > >
+                   > > > > > > > > > > > > > > > >
+    { };
+
+    /// @ingroup fec_stacks
+    /// @brief RLNC encoder which encodes data owned by the user.
+    ///
+    /// The configuration is the same as the full_rlnc_encoder except
+    /// that the partial shallow symbol storage is used instead of the
+    /// deep symbol storage. The encoder therefore keeps pointers to the
+    /// data passed to set_symbols() instead of copying it, see e.g. the
+    /// mapped_file_encoder.
+    template<class Field>
+    class shallow_full_rlnc_encoder :
+        public // Payload Codec API
+               payload_encoder<
+               // Codec Header API
+               systematic_encoder<
+               symbol_id_encoder<
+               // Symbol ID API
+               plain_symbol_id_writer<
+               // Coefficient Generator API
+               fast_uniform_generator<
+               // Codec API
+               encode_symbol_tracker<
+               linear_block_encoder<
+               storage_aware_encoder<
+               // Coefficient Storage API
+               coefficient_info<
+               // Symbol Storage API
+               partial_shallow_symbol_storage<
+               storage_bytes_used<
+               storage_block_info<
+               // Finite Field API
+               finite_field_math<typename fifi::default_field<Field>::type,
+               finite_field_info<Field,
+               // Factory API
+               final_coder_factory_pool<
+               // Final type
+               shallow_full_rlnc_encoder<Field
+                   > > > > > > > > > > > > > > > >
     { };
 
     /// Intermediate stack implementing the recoding functionality of a
@@ -104,14 +146,13 @@ namespace kodo
                  // Symbol ID API
                  recoding_symbol_id<
                  // Coefficient Generator API
-                 uniform_generator<
+                 fast_uniform_generator<
                  // Codec API
                  encode_symbol_tracker<
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  // Proxy
                  proxy_layer<
-                 recoding_stack<MainStack>, MainStack> > > > > > > > >
+                 recoding_stack<MainStack>, MainStack> > > > > > > >
     { };
 
     /// @ingroup fec_stacks
@@ -132,10 +173,12 @@ namespace kodo
                  // Symbol ID API
                  plain_symbol_id_reader<
                  // Codec API
+                 batch_linear_block_decoder<
                  aligned_coefficients_decoder<
+                 innovation_check_decoder<
                  forward_linear_block_decoder<
                  // Coefficient Storage API
-                 coefficient_storage<
+                 contiguous_coefficient_storage<
                  coefficient_info<
                  // Storage API
                  deep_symbol_storage<
@@ -148,9 +191,47 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  full_rlnc_decoder<Field>
-                     > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > > > >
     { };
 
-}
-
+    /// @ingroup fec_stacks
+    /// @brief RLNC decoder which decodes into memory owned by the user.
+    ///
+    /// The configuration is the same as the full_rlnc_decoder except
+    /// that the mutable shallow symbol storage is used instead of the
+    /// deep symbol storage. The decoder therefore decodes directly into
+    /// the buffer passed to set_symbols(), see e.g. the
+    /// parallel_object_decoder.
+    template<class Field>
+    class shallow_full_rlnc_decoder
+        : public // Payload API
+                 payload_recoder<recoding_stack,
+                 payload_decoder<
+                 // Codec Header API
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 // Symbol ID API
+                 plain_symbol_id_reader<
+                 // Codec API
+                 batch_linear_block_decoder<
+                 aligned_coefficients_decoder<
+                 innovation_check_decoder<
+                 forward_linear_block_decoder<
+                 // Coefficient Storage API
+                 contiguous_coefficient_storage<
+                 coefficient_info<
+                 // Storage API
+                 mutable_shallow_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 shallow_full_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > > >
+    { };
 
+}
@@ -41,10 +41,9 @@ namespace kodo
                plain_symbol_id_writer<
                // Coefficient Generator API
                storage_aware_generator<
-               uniform_generator<
+               fast_uniform_generator<
                // Codec API
                encode_symbol_tracker<
-               zero_symbol_encoder<
                linear_block_encoder<
                storage_aware_encoder<
                rank_info<
@@ -61,7 +60,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                on_the_fly_encoder<Field>
-               > > > > > > > > > > > > > > > > > > >
+               > > > > > > > > > > > > > > > > > >
     { };
 
     /// Intermediate stack implementing the recoding functionality of a
@@ -84,16 +83,15 @@ namespace kodo
                  // Symbol ID API
                  recoding_symbol_id<
                  // Coefficient Generator API
-                 uniform_generator<
+                 fast_uniform_generator<
                  // Codec API
                  encode_symbol_tracker<
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  rank_info<
                  // Proxy
                  proxy_layer<
                  on_the_fly_recoding_stack<MainStack>,
-                 MainStack> > > > > > > > > > >
+                 MainStack> > > > > > > > > >
     { };
 
 
@@ -117,11 +115,13 @@ namespace kodo
                // Symbol ID API
                plain_symbol_id_reader<
                // Codec API
+               batch_linear_block_decoder<
                aligned_coefficients_decoder<
+               innovation_check_decoder<
                forward_linear_block_decoder<
                rank_info<
                // Coefficient Storage API
-               coefficient_storage<
+               contiguous_coefficient_storage<
                coefficient_info<
                // Storage API
                deep_symbol_storage<
@@ -134,7 +134,7 @@ namespace kodo
                final_coder_factory_pool<
                // Final type
                on_the_fly_decoder<Field>
-               > > > > > > > > > > > > > > > > > >
+               > > > > > > > > > > > > > > > > > > > >
     { };
 
 }
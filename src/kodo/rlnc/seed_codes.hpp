@@ -10,11 +10,12 @@
 #include <fifi/default_field.hpp>
 
 #include "../aligned_coefficients_decoder.hpp"
+#include "../batch_linear_block_decoder.hpp"
+#include "../innovation_check_decoder.hpp"
 #include "../final_coder_factory_pool.hpp"
 #include "../final_coder_factory.hpp"
 #include "../finite_field_math.hpp"
 #include "../finite_field_info.hpp"
-#include "../zero_symbol_encoder.hpp"
 #include "../systematic_encoder.hpp"
 #include "../systematic_decoder.hpp"
 #include "../storage_bytes_used.hpp"
@@ -26,11 +27,14 @@
 #include "../symbol_id_encoder.hpp"
 #include "../symbol_id_decoder.hpp"
 #include "../coefficient_storage.hpp"
+#include "../contiguous_coefficient_storage.hpp"
 #include "../coefficient_info.hpp"
 #include "../plain_symbol_id_reader.hpp"
 #include "../seed_symbol_id_writer.hpp"
 #include "../seed_symbol_id_reader.hpp"
+#include "../cached_seed_symbol_id_reader.hpp"
 #include "../uniform_generator.hpp"
+#include "../splitmix64_generator_policy.hpp"
 #include "../recoding_symbol_id.hpp"
 #include "../proxy_layer.hpp"
 #include "../storage_aware_encoder.hpp"
@@ -66,7 +70,6 @@ namespace kodo
                  uniform_generator<
                  // Codec API
                  encode_symbol_tracker<
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  storage_aware_encoder<
                  // Coefficient Storage API
@@ -82,7 +85,7 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  seed_rlnc_encoder<Field>
-                     > > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > >
     { };
 
     /// @ingroup fec_stacks
@@ -103,10 +106,12 @@ namespace kodo
                  // Coefficient Generator API
                  uniform_generator<
                  // Codec API
+                 batch_linear_block_decoder<
                  aligned_coefficients_decoder<
+                 innovation_check_decoder<
                  forward_linear_block_decoder<
                  // Coefficient Storage API
-                 coefficient_storage<
+                 contiguous_coefficient_storage<
                  coefficient_info<
                  // Storage API
                  deep_symbol_storage<
@@ -119,9 +124,131 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  seed_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > > >
+    { };
+
+    /// @ingroup fec_stacks
+    /// @brief Seed based RLNC decoder which caches the regenerated
+    ///        encoding vectors.
+    ///
+    /// The configuration is the same as the seed_rlnc_decoder except
+    /// that the encoding vectors are kept in a seed_coefficient_cache
+    /// shared by the decoders built from the same factory, see the
+    /// cached_seed_symbol_id_reader. This pays off when the same
+    /// symbols are received several times e.g. over multiple paths.
+    template<class Field>
+    class cached_seed_rlnc_decoder
+        : public // Payload API
+                 payload_decoder<
+                 // Codec Header API
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 // Symbol ID API
+                 cached_seed_symbol_id_reader<
+                 // Coefficient Generator API
+                 uniform_generator<
+                 // Codec API
+                 batch_linear_block_decoder<
+                 aligned_coefficients_decoder<
+                 innovation_check_decoder<
+                 forward_linear_block_decoder<
+                 // Coefficient Storage API
+                 contiguous_coefficient_storage<
+                 coefficient_info<
+                 // Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field Math API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 cached_seed_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > > >
+    { };
+
+    /// @ingroup fec_stacks
+    /// @brief Seed based RLNC encoder generating the encoding vectors
+    ///        with the splitmix64_generator_policy.
+    ///
+    /// The configuration is the same as the seed_rlnc_encoder except
+    /// for the generator, which can be reseeded in constant time. The
+    /// seeds are written with a different version than those of the
+    /// seed_rlnc_encoder so they must be decoded by the
+    /// fast_seed_rlnc_decoder.
+    template<class Field>
+    class fast_seed_rlnc_encoder
+        : public // Payload Codec API
+                 payload_encoder<
+                 // Codec Header API
+                 systematic_encoder<
+                 symbol_id_encoder<
+                 // Symbol ID API
+                 seed_symbol_id_writer<
+                 // Coefficient Generator API
+                 basic_uniform_generator<splitmix64_generator_policy,
+                 // Codec API
+                 encode_symbol_tracker<
+                 linear_block_encoder<
+                 storage_aware_encoder<
+                 // Coefficient Storage API
+                 coefficient_info<
+                 // Symbol Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 fast_seed_rlnc_encoder<Field>
                      > > > > > > > > > > > > > > >
     { };
 
+    /// @ingroup fec_stacks
+    /// @brief Seed based RLNC decoder for the symbols produced by the
+    ///        fast_seed_rlnc_encoder.
+    ///
+    /// The generator is reseeded for every received symbol, which is
+    /// where the splitmix64_generator_policy saves the most compared to
+    /// the seed_rlnc_decoder.
+    template<class Field>
+    class fast_seed_rlnc_decoder
+        : public // Payload API
+                 payload_decoder<
+                 // Codec Header API
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 // Symbol ID API
+                 seed_symbol_id_reader<
+                 // Coefficient Generator API
+                 basic_uniform_generator<splitmix64_generator_policy,
+                 // Codec API
+                 batch_linear_block_decoder<
+                 aligned_coefficients_decoder<
+                 innovation_check_decoder<
+                 forward_linear_block_decoder<
+                 // Coefficient Storage API
+                 contiguous_coefficient_storage<
+                 coefficient_info<
+                 // Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field Math API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 fast_seed_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > > >
+    { };
+
 }
 
 
@@ -0,0 +1,124 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#include <fifi/default_field.hpp>
+
+#include "../aligned_coefficients_decoder.hpp"
+#include "../batch_linear_block_decoder.hpp"
+#include "../innovation_check_decoder.hpp"
+#include "../final_coder_factory_pool.hpp"
+#include "../finite_field_math.hpp"
+#include "../finite_field_info.hpp"
+#include "../systematic_encoder.hpp"
+#include "../systematic_decoder.hpp"
+#include "../storage_bytes_used.hpp"
+#include "../storage_block_info.hpp"
+#include "../deep_symbol_storage.hpp"
+#include "../payload_encoder.hpp"
+#include "../payload_decoder.hpp"
+#include "../symbol_id_encoder.hpp"
+#include "../symbol_id_decoder.hpp"
+#include "../contiguous_coefficient_storage.hpp"
+#include "../coefficient_info.hpp"
+#include "../sparse_symbol_id_reader.hpp"
+#include "../sparse_symbol_id_writer.hpp"
+#include "../geometric_sparse_generator.hpp"
+#include "../storage_aware_encoder.hpp"
+#include "../encode_symbol_tracker.hpp"
+
+#include "../linear_block_encoder.hpp"
+#include "../forward_linear_block_decoder.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup fec_stacks
+    /// @brief Complete stack implementing a sparse RLNC encoder.
+    ///
+    /// The key features of this configuration is the following:
+    /// - Systematic encoding (uncoded symbols produced before switching
+    ///   to coding)
+    /// - Sparse encoding vectors generated by the
+    ///   geometric_sparse_generator, the density is set with
+    ///   set_density().
+    /// - The encoding vectors are sent as a list of the non-zero
+    ///   coefficients when that is smaller than the full vector, see
+    ///   the sparse_symbol_id_writer.
+    /// - Deep symbol storage which makes the encoder allocate its own
+    ///   internal memory.
+    template<class Field>
+    class sparse_full_rlnc_encoder
+        : public // Payload Codec API
+                 payload_encoder<
+                 // Codec Header API
+                 systematic_encoder<
+                 symbol_id_encoder<
+                 // Symbol ID API
+                 sparse_symbol_id_writer<
+                 // Coefficient Generator API
+                 geometric_sparse_generator<
+                 // Codec API
+                 encode_symbol_tracker<
+                 linear_block_encoder<
+                 storage_aware_encoder<
+                 // Coefficient Storage API
+                 coefficient_info<
+                 // Symbol Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 sparse_full_rlnc_encoder<Field>
+                     > > > > > > > > > > > > > > >
+    { };
+
+    /// @ingroup fec_stacks
+    /// @brief Implementation of a decoder for the symbols produced by
+    ///        the sparse_full_rlnc_encoder.
+    ///
+    /// The configuration is the same as the full_rlnc_decoder except
+    /// that the symbol ids are read by the sparse_symbol_id_reader and
+    /// that recoding is not supported.
+    template<class Field>
+    class sparse_full_rlnc_decoder
+        : public // Payload API
+                 payload_decoder<
+                 // Codec Header API
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 // Symbol ID API
+                 sparse_symbol_id_reader<
+                 // Codec API
+                 batch_linear_block_decoder<
+                 aligned_coefficients_decoder<
+                 innovation_check_decoder<
+                 forward_linear_block_decoder<
+                 // Coefficient Storage API
+                 contiguous_coefficient_storage<
+                 coefficient_info<
+                 // Storage API
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 sparse_full_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > >
+    { };
+
+}
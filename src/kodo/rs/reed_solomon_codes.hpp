@@ -12,7 +12,6 @@
 #include "../final_coder_factory_pool.hpp"
 #include "../finite_field_math.hpp"
 #include "../finite_field_info.hpp"
-#include "../zero_symbol_encoder.hpp"
 #include "../systematic_encoder.hpp"
 #include "../systematic_decoder.hpp"
 #include "../storage_bytes_used.hpp"
@@ -56,7 +55,6 @@ namespace kodo
                  systematic_vandermonde_matrix<
                  // Codec API
                  encode_symbol_tracker<
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  storage_aware_encoder<
                  // Coefficient Storage API
@@ -72,7 +70,7 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  rs_encoder<Field>
-                     > > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > >
     { };
 
     /// @ingroup fec_stacks
@@ -0,0 +1,206 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace kodo
+{
+
+    /// @brief Bounded least recently used cache of coefficient vectors
+    ///        regenerated from seeds.
+    ///
+    /// The cache is keyed by a 64 bit value, the
+    /// cached_seed_symbol_id_reader combines the number of symbols and
+    /// the seed into the key. Vectors are copied in and out of the
+    /// cache since the decoders modify the coefficients in place. A
+    /// cache may be shared by decoders running on different threads.
+    class seed_coefficient_cache : boost::noncopyable
+    {
+    public:
+
+        /// The cache key type
+        typedef uint64_t key_type;
+
+    public:
+
+        /// Constructor
+        /// @param capacity The maximum number of cached vectors, a
+        ///        capacity of zero disables the cache
+        explicit seed_coefficient_cache(uint32_t capacity)
+            : m_capacity(capacity),
+              m_hits(0),
+              m_misses(0)
+        { }
+
+        /// Copies a cached vector to the destination buffer and marks
+        /// it as the most recently used
+        /// @param key The key of the vector
+        /// @param dest The destination buffer
+        /// @param size The size of the vector in bytes
+        /// @return True if the vector was found, otherwise the
+        ///         destination buffer is left untouched
+        bool find(key_type key, uint8_t *dest, uint32_t size)
+        {
+            assert(dest != 0);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_index.find(key);
+
+            if(it == m_index.end() || it->second->second.size() != size)
+            {
+                ++m_misses;
+                return false;
+            }
+
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+            const std::vector<uint8_t> &vector = it->second->second;
+            std::copy(vector.begin(), vector.end(), dest);
+
+            ++m_hits;
+            return true;
+        }
+
+        /// Stores a vector evicting the least recently used one if the
+        /// cache is full
+        /// @param key The key of the vector
+        /// @param src The vector
+        /// @param size The size of the vector in bytes
+        void insert(key_type key, const uint8_t *src, uint32_t size)
+        {
+            assert(src != 0);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if(m_capacity == 0)
+            {
+                return;
+            }
+
+            auto it = m_index.find(key);
+
+            if(it != m_index.end())
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                it->second->second.assign(src, src + size);
+                return;
+            }
+
+            if(m_entries.size() < m_capacity)
+            {
+                m_entries.push_front(entry_type());
+            }
+            else
+            {
+                // Reuse the memory of the least recently used entry
+                m_index.erase(m_entries.back().first);
+                m_entries.splice(m_entries.begin(), m_entries,
+                                 --m_entries.end());
+            }
+
+            m_entries.front().first = key;
+            m_entries.front().second.assign(src, src + size);
+
+            m_index[key] = m_entries.begin();
+        }
+
+        /// Sets the maximum number of cached vectors, the least recently
+        /// used vectors are evicted if the cache holds more
+        /// @param capacity The new capacity
+        void set_capacity(uint32_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_capacity = capacity;
+
+            while(m_entries.size() > m_capacity)
+            {
+                m_index.erase(m_entries.back().first);
+                m_entries.pop_back();
+            }
+        }
+
+        /// @return The maximum number of cached vectors
+        uint32_t capacity() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_capacity;
+        }
+
+        /// @return The number of cached vectors
+        uint32_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return static_cast<uint32_t>(m_entries.size());
+        }
+
+        /// @return The number of lookups which found a vector
+        uint64_t hits() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+        /// @return The number of lookups which did not find a vector
+        uint64_t misses() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_misses;
+        }
+
+        /// Removes all cached vectors and resets the counters
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_entries.clear();
+            m_index.clear();
+
+            m_hits = 0;
+            m_misses = 0;
+        }
+
+    private:
+
+        /// A cached vector and its key
+        typedef std::pair<key_type, std::vector<uint8_t> > entry_type;
+
+        /// The list of entries ordered from most to least recently used
+        typedef std::list<entry_type> entry_list;
+
+    private:
+
+        /// Protects the entries and counters
+        mutable std::mutex m_mutex;
+
+        /// The maximum number of cached vectors
+        uint32_t m_capacity;
+
+        /// The cached vectors
+        entry_list m_entries;
+
+        /// Lookup of the entries by key
+        std::unordered_map<key_type, entry_list::iterator> m_index;
+
+        /// The number of lookups which found a vector
+        uint64_t m_hits;
+
+        /// The number of lookups which did not find a vector
+        uint64_t m_misses;
+
+    };
+
+}
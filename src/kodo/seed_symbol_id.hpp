@@ -6,6 +6,7 @@
 #ifndef KODO_SEED_SYMBOL_ID_HPP
 #define KODO_SEED_SYMBOL_ID_HPP
 
+#include <cassert>
 #include <cstdint>
 
 #include <fifi/fifi_utils.hpp>
@@ -15,6 +16,20 @@ namespace kodo
 
     /// @ingroup symbol_id_layers
     /// @brief Base layer for seed symbol id reader and writers
+    ///
+    /// The symbol id is a seed_type value where the high byte holds the
+    /// seed_version of the generator policy and the remaining low bits
+    /// hold the seed. A decoder using a different generator than the
+    /// encoder can thereby detect the mismatch instead of decoding
+    /// with the wrong coefficients.
+    ///
+    /// The seed is limited to the low bits, i.e. with a 32-bit seed an
+    /// encoder can produce 2^24 coded symbols per block. Larger seeds
+    /// would wrap and repeat earlier coefficient vectors, so writing one
+    /// is an error. The mt19937_generator_policy has version 0, so its
+    /// symbol ids are unchanged from earlier releases within this
+    /// limit. Earlier releases used the full seed for the symbol count;
+    /// symbols past 2^24 from such encoders are rejected by the reader.
     template<class SuperCoder>
     class seed_symbol_id
         : public aligned_coefficients_buffer<SuperCoder>
@@ -27,10 +42,24 @@ namespace kodo
         /// The seed type from the generator used
         typedef typename Super::seed_type seed_type;
 
+        /// The random generator used, which defines the version of
+        /// the seeds
+        typedef typename Super::generator_type generator_type;
+
         /// The seed should be integral
         static_assert(std::is_integral<seed_type>::value,
                       "Seed must have an integral type");
 
+        /// The high byte of the seed holds the version
+        static_assert(sizeof(seed_type) > 1,
+                      "Seed must be larger than the version");
+
+        /// The number of low bits of the symbol id holding the seed
+        static const uint32_t seed_bits = 8 * (sizeof(seed_type) - 1);
+
+        /// The largest seed which can be stored in a symbol id
+        static const seed_type max_seed = (seed_type(1) << seed_bits) - 1;
+
     public:
 
         /// @ingroup factory_layers
@@ -60,6 +89,30 @@ namespace kodo
                 return sizeof(seed_type);
             }
 
+    protected:
+
+        /// @param seed The seed
+        /// @return The symbol id holding the seed and the version of the
+        ///         generator
+        static seed_type versioned_seed(seed_type seed)
+            {
+                // The seed would overwrite the version and repeat the
+                // coefficients of an earlier seed
+                assert(seed <= max_seed);
+
+                seed_type version = generator_type::seed_version;
+
+                return (version << seed_bits) | seed;
+            }
+
+        /// @param id A symbol id
+        /// @return True if the symbol id was written using the same
+        ///         version of the generator as used by this coder
+        static bool has_seed_version(seed_type id)
+            {
+                return (id >> seed_bits) == generator_type::seed_version;
+            }
+
     };
 
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
 
 #include <fifi/fifi_utils.hpp>
 
@@ -16,7 +17,8 @@ namespace kodo
 
     /// @brief Reads the seed from the symbol_id buffer and uses it to seed
     ///        the generator layer, which produces the corresponding coding
-    ///        coefficients.
+    ///        coefficients. Symbols written with a different version of
+    ///        the generator get zero coefficients.
     ///
     /// @ingroup symbol_id_layers
     template<class SuperCoder>
@@ -40,13 +42,21 @@ namespace kodo
 
             seed_type seed = sak::big_endian::get<seed_type>(symbol_id);
 
+            *symbol_coefficients = &m_coefficients[0];
+
+            if(!Super::has_seed_version(seed))
+            {
+                // The symbol was encoded using a different generator,
+                // zero coefficients make the decoder drop it
+                std::fill(m_coefficients.begin(), m_coefficients.end(), 0);
+                return;
+            }
+
             Super::seed(seed);
             Super::generate(&m_coefficients[0]);
-
-            *symbol_coefficients = &m_coefficients[0];
         }
 
-    private:
+    protected:
 
         /// Access the buffer in the coefficients buffer
         /// layer used by the seed_symbol_id layer
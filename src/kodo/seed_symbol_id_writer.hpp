@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <stdexcept>
 
 #include <fifi/fifi_utils.hpp>
 
@@ -18,6 +19,16 @@ namespace kodo
     ///        generator layer before generating the coefficients.
     ///        The current symbol count is used as the seed.
     ///        Which allows the decoder to reproduce the coefficients used.
+    ///        The version of the generator is stored in the high byte of
+    ///        the seed, see seed_symbol_id. An encoder can therefore
+    ///        produce at most seed_symbol_id::max_seed + 1 coded symbols,
+    ///        which can be checked with has_seed(). Writing further ids
+    ///        throws std::out_of_range.
+    ///
+    ///        When a batch is encoded all ids are written before any of
+    ///        the symbols are encoded, so the ids written since the last
+    ///        encode are added to the symbol count to keep the seeds
+    ///        identical to those of encoding the symbols one at a time.
     ///
     /// @ingroup symbol_id_layers
     template<class SuperCoder>
@@ -33,14 +44,49 @@ namespace kodo
 
     public:
 
+        /// Constructor
+        seed_symbol_id_writer()
+            : m_pending_ids(0)
+        { }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            Super::initialize(the_factory);
+            m_pending_ids = 0;
+        }
+
+        /// @return True if a seed is left for the next symbol id. Once
+        ///         all seeds are used no further ids may be written,
+        ///         since they would repeat earlier coefficient vectors.
+        bool has_seed() const
+            {
+                uint64_t count = uint64_t(Super::encode_symbol_count()) +
+                    m_pending_ids;
+
+                return count <= Super::max_seed;
+            }
+
+        /// Throws std::out_of_range if no seed is left, see has_seed()
+        ///
         /// @copydoc layer::write_id(uint8_t*, uint8_t**)
         uint32_t write_id(uint8_t *symbol_id, uint8_t **coefficients)
             {
                 assert(symbol_id != 0);
                 assert(coefficients != 0);
 
-                seed_type seed =
-                    (seed_type) Super::encode_symbol_count();
+                if(!has_seed())
+                {
+                    throw std::out_of_range(
+                        "seed_symbol_id_writer: all seeds of the block "
+                        "are used");
+                }
+
+                seed_type seed = Super::versioned_seed((seed_type)
+                    (Super::encode_symbol_count() + m_pending_ids));
+
+                ++m_pending_ids;
 
                 Super::seed(seed);
                 Super::generate(&m_coefficients[0]);
@@ -52,12 +98,36 @@ namespace kodo
                 return sizeof(seed_type);
             }
 
+        /// @copydoc layer::encode_symbol(uint8_t*, uint8_t*)
+        void encode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            m_pending_ids = 0;
+            Super::encode_symbol(symbol_data, coefficients);
+        }
+
+        /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
+        void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            Super::encode_symbol(symbol_data, symbol_index);
+        }
+
+        /// @copydoc layer::encode_symbols(uint8_t**,uint8_t**,uint32_t)
+        void encode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            m_pending_ids = 0;
+            Super::encode_symbols(symbol_data, coefficients, count);
+        }
+
     private:
 
         /// Access the buffer in the coefficients buffer
         /// layer used by the seed_symbol_id layer
         using Super::m_coefficients;
 
+        /// The number of ids written which have not yet been encoded
+        uint32_t m_pending_ids;
+
     };
 
 }
@@ -71,7 +71,7 @@ namespace kodo
             ///         does not fully cover all decoders we may require
             ///         additional memory to be able to provide all
             ///         decoders with the memory needed.
-            uint32_t total_block_size(uint32_t object_size) const
+            uint64_t total_block_size(uint64_t object_size) const
             {
                 partitioning p(DecoderType::factory::max_symbols(),
                                DecoderType::factory::max_symbol_size(),
@@ -89,14 +89,34 @@ namespace kodo
         /// @param decoding_buffer The storage where the object will be
         ///        decoded. The memory used must be zero initialized.
         shallow_storage_decoder(
-            factory &factory, uint32_t object_size,
+            factory &factory, uint64_t object_size,
             const sak::mutable_storage &decoding_storage) :
             base_decoder(factory, object_size),
-            m_decoding_storage(decoding_storage)
+            m_data(decoding_storage.m_data),
+            m_size(decoding_storage.m_size)
         {
             // We have to make sure the decoding buffer is large enough
-            assert(factory.total_block_size(object_size) ==
-                   m_decoding_storage.m_size);
+            assert(factory.total_block_size(object_size) == m_size);
+        }
+
+        /// Constructs a new storage decoder for buffers which may be
+        /// larger than a sak::mutable_storage can describe
+        /// @param factory The decoder factory to use
+        /// @param object_size The size of the object to be decoded in bytes
+        /// @param data The buffer where the object will be decoded. The
+        ///        memory used must be zero initialized.
+        /// @param size The size of the buffer in bytes
+        shallow_storage_decoder(
+            factory &factory, uint64_t object_size,
+            uint8_t *data, uint64_t size) :
+            base_decoder(factory, object_size),
+            m_data(data),
+            m_size(size)
+        {
+            assert(m_data != 0);
+
+            // We have to make sure the decoding buffer is large enough
+            assert(factory.total_block_size(object_size) == m_size);
         }
 
         /// @copydoc object_decoder::build(uint32_t)
@@ -104,25 +124,25 @@ namespace kodo
         {
             auto decoder = base_decoder::build(decoder_id);
 
-            uint32_t offset = m_partitioning.byte_offset(decoder_id);
+            uint64_t offset = m_partitioning.byte_offset(decoder_id);
             uint32_t block_size = m_partitioning.block_size(decoder_id);
 
-            sak::mutable_storage data = m_decoding_storage + offset;
-            assert(data.m_size >= block_size);
+            assert(offset + block_size <= m_size);
 
-            // Adjust the size of the decoding buffer to fit this
-            // decoder
-            data.m_size = block_size;
-
-            decoder->set_symbols(data);
+            // Offset the buffer with the 64 bit offset, only the block
+            // itself is wrapped in a storage object
+            decoder->set_symbols(sak::storage(m_data + offset, block_size));
 
             return decoder;
         }
 
     private:
 
-        /// The storage where the decoded data should be placed
-        sak::mutable_storage m_decoding_storage;
+        /// The buffer where the decoded data should be placed
+        uint8_t *m_data;
+
+        /// The size of the buffer in bytes
+        uint64_t m_size;
 
     };
 
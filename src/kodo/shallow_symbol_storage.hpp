@@ -65,7 +65,7 @@ namespace kodo
         {
             SuperCoder::initialize(the_factory);
 
-            std::fill(m_data.begin(), m_data.end(), (data_ptr) 0);
+            std::fill_n(m_data.begin(), SuperCoder::symbols(), (data_ptr) 0);
             m_symbols_count = 0;
         }
 
@@ -0,0 +1,182 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+
+#include <fifi/fifi_utils.hpp>
+
+#include "aligned_coefficients_buffer.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup symbol_id_layers
+    /// @brief Base layer for the sparse symbol id reader and writer
+    ///
+    /// The first byte of the symbol id selects the format of the rest:
+    ///
+    /// - dense_format: the coding coefficients as written by the
+    ///   plain_symbol_id_writer.
+    /// - sparse_format: the number of non-zero coefficients followed by
+    ///   the position and value of each of them. The positions are
+    ///   written in increasing order as the distance from the previous
+    ///   position, and the distances and the count as variable length
+    ///   integers with 7 bits per byte. The values are written in big
+    ///   endian and left out for the binary field where they are always
+    ///   one.
+    ///
+    /// The writer picks the smaller of the two for every symbol.
+    template<class SuperCoder>
+    class sparse_symbol_id
+        : public aligned_coefficients_buffer<SuperCoder>
+    {
+    public:
+
+        /// Type of SuperCoder with injected aligned_coefficient_buffer
+        typedef aligned_coefficients_buffer<SuperCoder> Super;
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Super::value_type value_type;
+
+        /// Format byte of a symbol id holding the full coefficients
+        static const uint8_t dense_format = 0;
+
+        /// Format byte of a symbol id holding the non-zero coefficients
+        static const uint8_t sparse_format = 1;
+
+    public:
+
+        /// @ingroup factory_layers
+        /// The factory layer associated with this coder.
+        class factory : public Super::factory
+        {
+        public:
+
+            /// @copydoc layer::factory::factory(uint32_t,uint32_t)
+            factory(uint32_t max_symbols, uint32_t max_symbol_size)
+                : Super::factory(max_symbols, max_symbol_size)
+            { }
+
+            /// @copydoc layer::factory::max_id_size() const
+            uint32_t max_id_size() const
+            {
+                return 1 + Super::factory::max_coefficients_size();
+            }
+        };
+
+    public:
+
+        /// @copydoc layer::id_size() const
+        uint32_t id_size() const
+        {
+            return 1 + Super::coefficients_size();
+        }
+
+    protected:
+
+        /// @return The number of bytes used for every non-zero value in
+        ///         the sparse format
+        static uint32_t value_size()
+        {
+            return fifi::is_binary<field_type>::value ?
+                0 : sizeof(value_type);
+        }
+
+        /// @param value An unsigned integer
+        /// @return The number of bytes used to write the value as a
+        ///         variable length integer
+        static uint32_t varint_size(uint32_t value)
+        {
+            uint32_t size = 1;
+
+            while(value >= 0x80)
+            {
+                value >>= 7;
+                ++size;
+            }
+
+            return size;
+        }
+
+        /// Writes a variable length integer
+        /// @param value The value to write
+        /// @param buffer The buffer to write to
+        /// @return The number of bytes written
+        static uint32_t put_varint(uint32_t value, uint8_t *buffer)
+        {
+            uint32_t size = 0;
+
+            while(value >= 0x80)
+            {
+                buffer[size++] = uint8_t(value | 0x80);
+                value >>= 7;
+            }
+
+            buffer[size++] = uint8_t(value);
+
+            return size;
+        }
+
+        /// The largest number of bytes of a variable length integer
+        static const uint32_t max_varint_size = 5;
+
+        /// Reads a variable length integer
+        /// @param buffer The buffer to read from
+        /// @param available The number of bytes left in the buffer
+        /// @param value The value read
+        /// @return The number of bytes read or 0 if the buffer does not
+        ///         hold a valid 32 bit variable length integer
+        static uint32_t get_varint(const uint8_t *buffer, uint32_t available,
+                                   uint32_t &value)
+        {
+            uint32_t limit = std::min(available, max_varint_size);
+
+            value = 0;
+
+            for(uint32_t size = 0; size < limit; ++size)
+            {
+                uint32_t bits = buffer[size] & 0x7f;
+
+                // The last byte only has room for the top 4 bits
+                if(size == max_varint_size - 1 && bits > 0x0f)
+                {
+                    return 0;
+                }
+
+                value |= bits << (7 * size);
+
+                if(!(buffer[size] & 0x80))
+                {
+                    return size + 1;
+                }
+            }
+
+            return 0;
+        }
+
+    protected:
+
+        /// The coefficient buffer
+        using Super::m_coefficients;
+
+    };
+
+    template<class SuperCoder>
+    const uint8_t sparse_symbol_id<SuperCoder>::dense_format;
+
+    template<class SuperCoder>
+    const uint8_t sparse_symbol_id<SuperCoder>::sparse_format;
+
+    template<class SuperCoder>
+    const uint32_t sparse_symbol_id<SuperCoder>::max_varint_size;
+
+}
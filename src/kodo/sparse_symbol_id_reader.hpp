@@ -0,0 +1,147 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+
+#include <fifi/fifi_utils.hpp>
+
+#include <sak/convert_endian.hpp>
+
+#include "sparse_symbol_id.hpp"
+
+namespace kodo
+{
+
+    /// @brief Reads the coding coefficients written by the
+    ///        sparse_symbol_id_writer.
+    ///
+    /// Dense symbol ids are used in place like the plain_symbol_id_reader
+    /// does. The non-zero coefficients of sparse symbol ids are written
+    /// to a zeroed coefficient vector, which the decoders scan a word at
+    /// a time. Symbol ids with an unknown format or malformed sparse
+    /// data are given zero coefficients, so the decoders drop them.
+    ///
+    /// @see sparse_symbol_id for the format of the symbol id.
+    ///
+    /// @ingroup symbol_id_layers
+    template<class SuperCoder>
+    class sparse_symbol_id_reader : public sparse_symbol_id<SuperCoder>
+    {
+    public:
+
+        /// Type of SuperCoder with injected aligned_coefficient_buffer
+        typedef sparse_symbol_id<SuperCoder> Super;
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Super::value_type value_type;
+
+    public:
+
+        /// @copydoc layer::read_id(uint8_t*, uint8_t**)
+        void read_id(uint8_t *symbol_id, uint8_t **symbol_coefficients)
+        {
+            assert(symbol_id != 0);
+            assert(symbol_coefficients != 0);
+
+            if(symbol_id[0] == Super::dense_format)
+            {
+                *symbol_coefficients = symbol_id + 1;
+                return;
+            }
+
+            *symbol_coefficients = &m_coefficients[0];
+
+            std::fill_n(m_coefficients.begin(),
+                        Super::coefficients_size(), 0);
+
+            if(symbol_id[0] != Super::sparse_format ||
+               !read_sparse(symbol_id))
+            {
+                // The symbol id is malformed, zero coefficients make the
+                // decoder drop the symbol
+                std::fill_n(m_coefficients.begin(),
+                            Super::coefficients_size(), 0);
+            }
+        }
+
+    protected:
+
+        /// Writes the non-zero coefficients of a sparse symbol id to the
+        /// zeroed coefficient buffer. No more than layer::id_size() bytes
+        /// of the symbol id are read.
+        /// @param symbol_id The symbol id
+        /// @return False if the symbol id is malformed
+        bool read_sparse(const uint8_t *symbol_id)
+        {
+            value_type *c =
+                reinterpret_cast<value_type*>(&m_coefficients[0]);
+
+            uint32_t symbols = Super::symbols();
+            uint32_t size = Super::id_size();
+            uint32_t offset = 1;
+
+            uint32_t count = 0;
+            uint32_t read = Super::get_varint(
+                symbol_id + offset, size - offset, count);
+
+            if(read == 0 || count > symbols)
+            {
+                return false;
+            }
+
+            offset += read;
+
+            uint32_t position = 0;
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                uint32_t delta = 0;
+                read = Super::get_varint(
+                    symbol_id + offset, size - offset, delta);
+
+                if(read == 0 || delta >= symbols - position)
+                {
+                    return false;
+                }
+
+                offset += read;
+                position += delta;
+
+                value_type value = 1;
+
+                if(Super::value_size() > 0)
+                {
+                    if(Super::value_size() > size - offset)
+                    {
+                        return false;
+                    }
+
+                    value = sak::big_endian::get<value_type>(
+                        symbol_id + offset);
+
+                    offset += Super::value_size();
+                }
+
+                fifi::set_value<field_type>(c, position, value);
+            }
+
+            return true;
+        }
+
+    private:
+
+        /// The coefficient buffer
+        using Super::m_coefficients;
+
+    };
+
+}
@@ -0,0 +1,266 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <fifi/fifi_utils.hpp>
+
+#include <sak/convert_endian.hpp>
+
+#include "find_nonzero.hpp"
+#include "has_geometric_sparse_generator.hpp"
+#include "sparse_symbol_id.hpp"
+
+namespace kodo
+{
+
+    /// @brief Generates the coding coefficients and writes them to the
+    ///        symbol id either in full or as a list of the non-zero
+    ///        coefficients, whichever is smaller.
+    ///
+    /// If the generator records the positions of the non-zero
+    /// coefficients, see basic_geometric_sparse_generator, those are
+    /// used instead of scanning the coefficient vector. Whenever the
+    /// complete list of positions is known the symbol is encoded with
+    /// layer::encode_sparse_symbol().
+    ///
+    /// @see sparse_symbol_id for the format of the symbol id.
+    ///
+    /// @ingroup symbol_id_layers
+    template<class SuperCoder>
+    class sparse_symbol_id_writer : public sparse_symbol_id<SuperCoder>
+    {
+    public:
+
+        /// Type of SuperCoder with injected aligned_coefficient_buffer
+        typedef sparse_symbol_id<SuperCoder> Super;
+
+        /// @copydoc layer::field_type
+        typedef typename Super::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename Super::value_type value_type;
+
+        /// True if the generator provides the positions of the non-zero
+        /// coefficients of the vector generated
+        typedef std::integral_constant<bool,
+            has_geometric_sparse_generator<SuperCoder>::value>
+            generator_positions;
+
+    public:
+
+        /// Constructor
+        sparse_symbol_id_writer()
+            : m_count(0),
+              m_positions_valid(false)
+        { }
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            Super::construct(the_factory);
+
+            m_positions.resize(the_factory.max_symbols(), 0);
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            Super::initialize(the_factory);
+
+            m_count = 0;
+            m_positions_valid = false;
+        }
+
+        /// @copydoc layer::write_id(uint8_t*, uint8_t**)
+        uint32_t write_id(uint8_t *symbol_id, uint8_t **coefficients)
+        {
+            assert(symbol_id != 0);
+            assert(coefficients != 0);
+
+            Super::generate(&m_coefficients[0]);
+            *coefficients = &m_coefficients[0];
+
+            if(collect_positions(generator_positions()))
+            {
+                return write_sparse(symbol_id);
+            }
+
+            symbol_id[0] = Super::dense_format;
+
+            std::copy(m_coefficients.begin(),
+                      m_coefficients.begin() + Super::coefficients_size(),
+                      symbol_id + 1);
+
+            return 1 + Super::coefficients_size();
+        }
+
+        /// Uses layer::encode_sparse_symbol() if the coefficients are
+        /// those of the last id written and all their positions are known
+        ///
+        /// @copydoc layer::encode_symbol(uint8_t*, uint8_t*)
+        void encode_symbol(uint8_t *symbol_data, uint8_t *coefficients)
+        {
+            if(!m_positions_valid || coefficients != &m_coefficients[0])
+            {
+                Super::encode_symbol(symbol_data, coefficients);
+                return;
+            }
+
+            m_positions_valid = false;
+
+            Super::encode_sparse_symbol(
+                symbol_data, coefficients, &m_positions[0], m_count);
+        }
+
+        /// @copydoc layer::encode_symbol(uint8_t*,uint32_t)
+        void encode_symbol(uint8_t *symbol_data, uint32_t symbol_index)
+        {
+            Super::encode_symbol(symbol_data, symbol_index);
+        }
+
+        /// @copydoc layer::encode_symbols(uint8_t**,uint8_t**,uint32_t)
+        void encode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            m_positions_valid = false;
+            Super::encode_symbols(symbol_data, coefficients, count);
+        }
+
+    protected:
+
+        /// Copies the positions recorded by the generator
+        /// @return True if the sparse format should be used
+        bool collect_positions(std::true_type)
+        {
+            const uint32_t *positions = Super::nonzero_positions();
+
+            uint32_t dense_size = Super::coefficients_size();
+
+            // The size of the entries, the count is added at the end
+            uint32_t size = 0;
+            uint32_t previous = 0;
+
+            m_count = Super::nonzero_count();
+
+            for(uint32_t k = 0; k < m_count; ++k)
+            {
+                uint32_t i = positions[k];
+
+                size += Super::varint_size(i - previous) +
+                    Super::value_size();
+
+                m_positions[k] = i;
+                previous = i;
+            }
+
+            m_positions_valid = true;
+
+            return size + Super::varint_size(m_count) < dense_size;
+        }
+
+        /// Collects the positions of the non-zero coefficients as long
+        /// as the sparse format is smaller than the dense one
+        /// @return True if the sparse format should be used
+        bool collect_positions(std::false_type)
+        {
+            const value_type *c =
+                reinterpret_cast<const value_type*>(&m_coefficients[0]);
+
+            uint32_t symbols = Super::symbols();
+            uint32_t dense_size = Super::coefficients_size();
+
+            // The size of the entries, the count is added at the end
+            uint32_t size = 0;
+            uint32_t previous = 0;
+
+            m_count = 0;
+            m_positions_valid = false;
+
+            for(uint32_t i = find_nonzero<field_type>(c, 0, symbols);
+                i < symbols;
+                i = find_nonzero<field_type>(c, i + 1, symbols))
+            {
+                size += Super::varint_size(i - previous) +
+                    Super::value_size();
+
+                if(size >= dense_size)
+                {
+                    return false;
+                }
+
+                m_positions[m_count] = i;
+                ++m_count;
+
+                previous = i;
+            }
+
+            m_positions_valid = true;
+
+            return size + Super::varint_size(m_count) < dense_size;
+        }
+
+        /// Writes the collected positions and their values
+        /// @param symbol_id The symbol id buffer
+        /// @return The number of bytes written
+        uint32_t write_sparse(uint8_t *symbol_id)
+        {
+            const value_type *c =
+                reinterpret_cast<const value_type*>(&m_coefficients[0]);
+
+            symbol_id[0] = Super::sparse_format;
+
+            uint32_t offset = 1;
+            offset += Super::put_varint(m_count, symbol_id + offset);
+
+            uint32_t previous = 0;
+
+            for(uint32_t k = 0; k < m_count; ++k)
+            {
+                uint32_t i = m_positions[k];
+
+                offset += Super::put_varint(i - previous, symbol_id + offset);
+                previous = i;
+
+                if(Super::value_size() > 0)
+                {
+                    value_type value = fifi::get_value<field_type>(c, i);
+
+                    sak::big_endian::put<value_type>(
+                        value, symbol_id + offset);
+
+                    offset += Super::value_size();
+                }
+            }
+
+            return offset;
+        }
+
+    private:
+
+        /// The coefficient buffer
+        using Super::m_coefficients;
+
+        /// The positions of the non-zero coefficients
+        std::vector<uint32_t> m_positions;
+
+        /// The number of non-zero coefficients
+        uint32_t m_count;
+
+        /// True if m_positions holds all non-zero positions of the
+        /// coefficients of the last id written and they are not encoded
+        bool m_positions_valid;
+
+    };
+
+}
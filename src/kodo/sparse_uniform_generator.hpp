@@ -8,20 +8,21 @@
 #include <cstdint>
 #include <cassert>
 
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/bernoulli_distribution.hpp>
 
 #include <fifi/is_binary.hpp>
 #include <fifi/fifi_utils.hpp>
 
+#include "mt19937_generator_policy.hpp"
+
 namespace kodo
 {
     /// @ingroup coefficient_generator_layers
     /// @brief Generate uniformly distributed coefficients with a specific
-    /// density
-    template<class SuperCoder>
-    class sparse_uniform_generator : public SuperCoder
+    /// density using the random generator given by the GeneratorPolicy
+    template<class GeneratorPolicy, class SuperCoder>
+    class basic_sparse_uniform_generator : public SuperCoder
     {
     public:
 
@@ -32,15 +33,15 @@ namespace kodo
         typedef typename SuperCoder::value_type value_type;
 
         /// The random generator used
-        typedef boost::random::mt19937 generator_type;
+        typedef GeneratorPolicy generator_type;
 
         /// @copydoc layer::seed_type
-        typedef generator_type::result_type seed_type;
+        typedef typename generator_type::seed_type seed_type;
 
     public:
 
         /// Constructor
-        sparse_uniform_generator()
+        basic_sparse_uniform_generator()
             : m_bernoulli(0.5),
               m_value_distribution(1, field_type::max_value)
         { }
@@ -149,8 +150,17 @@ namespace kodo
         value_type_distribution m_value_distribution;
 
         /// The random generator
-        boost::random::mt19937 m_random_generator;
+        generator_type m_random_generator;
 
     };
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Sparse uniform coefficient generator using the
+    /// mt19937_generator_policy
+    template<class SuperCoder>
+    class sparse_uniform_generator : public
+        basic_sparse_uniform_generator<mt19937_generator_policy, SuperCoder>
+    { };
+
 }
 
@@ -0,0 +1,122 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+
+    /// @brief Random generator policy for the coefficient generators
+    ///        based on the splitmix64 counter-mode hash.
+    ///
+    /// The generator state is a counter which is advanced by a constant
+    /// for every step, and every step hashes the counter into 64 random
+    /// bits. Seeding only stores the seed in the counter, so the policy
+    /// is intended for the seed codes where the decoder reseeds the
+    /// generator for every received symbol. The bytes are written in
+    /// little endian order so a seed produces the same coefficients on
+    /// all platforms.
+    ///
+    /// The policy models the boost UniformRandomNumberGenerator concept.
+    ///
+    /// @see mt19937_generator_policy
+    class splitmix64_generator_policy
+    {
+    public:
+
+        /// The type of the values produced
+        typedef uint64_t result_type;
+
+        /// The type of the seed
+        typedef uint32_t seed_type;
+
+        /// The version of the seeds written by the seed codes using
+        /// this policy, see seed_symbol_id
+        static const uint8_t seed_version = 1;
+
+    public:
+
+        /// Constructor
+        splitmix64_generator_policy()
+            : m_counter(0)
+        { }
+
+        /// Seeds the generator
+        /// @param seed_value The seed
+        void seed(seed_type seed_value)
+        {
+            m_counter = seed_value;
+        }
+
+        /// Fills a buffer with uniformly distributed random bytes
+        /// @param data The buffer
+        /// @param size The size of the buffer in bytes
+        void fill(uint8_t *data, uint32_t size)
+        {
+            assert(data != 0);
+
+            uint32_t i = 0;
+
+            for(; i + 8 <= size; i += 8)
+            {
+                uint64_t value = next();
+
+                for(uint32_t j = 0; j < 8; ++j)
+                {
+                    data[i + j] = uint8_t(value >> (8 * j));
+                }
+            }
+
+            if(i < size)
+            {
+                uint64_t value = next();
+
+                for(uint32_t j = 0; i + j < size; ++j)
+                {
+                    data[i + j] = uint8_t(value >> (8 * j));
+                }
+            }
+        }
+
+        /// @return The next random value
+        result_type operator()()
+        {
+            return next();
+        }
+
+        /// @return The smallest value produced
+        static result_type min()
+        {
+            return 0;
+        }
+
+        /// @return The largest value produced
+        static result_type max()
+        {
+            return ~result_type(0);
+        }
+
+    private:
+
+        /// @return The hash of the next counter value
+        uint64_t next()
+        {
+            uint64_t z = (m_counter += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+
+        /// The counter hashed by the generator
+        uint64_t m_counter;
+
+    };
+
+}
@@ -7,6 +7,8 @@
 
 #include <cstdint>
 
+#include "pivot_bitmap.hpp"
+
 namespace kodo
 {
 
@@ -17,12 +19,61 @@ namespace kodo
     /// This kind of functionality is needed when an encoder should be
     /// able to support encoding before all symbols are ready. The
     /// coefficient generator layers uses this information to create
-    /// partial coefficient vectors if needed.
+    /// partial coefficient vectors if needed. The initialized symbols
+    /// are also tracked in a pivot_bitmap which the generators may scan
+    /// a word at a time.
     template<class SuperCoder>
     class storage_aware_encoder : public SuperCoder
     {
     public:
 
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_pivots.resize(the_factory.max_symbols());
+        }
+
+        /// @copydoc layer::initialize(Factory&)
+        template<class Factory>
+        void initialize(Factory &the_factory)
+        {
+            SuperCoder::initialize(the_factory);
+
+            m_pivots.reset(the_factory.symbols());
+            update_pivots();
+        }
+
+        /// @copydoc layer::set_symbols(const sak::const_storage&)
+        template<class Storage>
+        void set_symbols(const Storage &symbol_storage)
+        {
+            SuperCoder::set_symbols(symbol_storage);
+            update_pivots();
+        }
+
+        /// @copydoc layer::set_symbol(uint32_t, const sak::const_storage&)
+        template<class Storage>
+        void set_symbol(uint32_t index, const Storage &symbol)
+        {
+            SuperCoder::set_symbol(index, symbol);
+
+            if(SuperCoder::is_symbol_initialized(index))
+            {
+                m_pivots.set(index);
+            }
+        }
+
+        /// @copydoc layer::swap_symbols(std::vector<uint8_t>&)
+        template<class Symbols>
+        void swap_symbols(Symbols &symbols)
+        {
+            SuperCoder::swap_symbols(symbols);
+            update_pivots();
+        }
+
         /// @copydoc layer::rank() const
         uint32_t rank() const
         {
@@ -36,6 +87,32 @@ namespace kodo
             return SuperCoder::is_symbol_initialized(index);
         }
 
+        /// @copydoc layer::symbol_pivots() const
+        const pivot_bitmap& symbol_pivots() const
+        {
+            return m_pivots;
+        }
+
+    private:
+
+        /// Updates the pivot bitmap from the storage status
+        void update_pivots()
+        {
+            for(uint32_t i = m_pivots.find_next_unset(0);
+                i < m_pivots.size(); i = m_pivots.find_next_unset(i + 1))
+            {
+                if(SuperCoder::is_symbol_initialized(i))
+                {
+                    m_pivots.set(i);
+                }
+            }
+        }
+
+    private:
+
+        /// Tracks the initialized symbols
+        pivot_bitmap m_pivots;
+
     };
 
 }
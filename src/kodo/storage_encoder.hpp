@@ -50,6 +50,22 @@ namespace kodo
                   >
               (factory, storage_reader<EncoderType>(data))
             { }
+
+        /// Constructs a new storage encoder for objects which may be
+        /// larger than a sak::const_storage can describe
+        /// @param factory the encoder factory to use
+        /// @param data the object to encode
+        /// @param size the size of the object in bytes
+        storage_encoder(typename EncoderType::factory &factory,
+                        const uint8_t *data, uint64_t size)
+            : object_encoder
+                  <
+                  storage_reader<EncoderType>,
+                  EncoderType,
+                  BlockPartitioning
+                  >
+              (factory, storage_reader<EncoderType>(data, size))
+            { }
     };
 }
 
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <cassert>
+#include <cstdint>
+
 #include <sak/storage.hpp>
 
 namespace kodo
@@ -34,37 +37,46 @@ namespace kodo
         /// wrapped by the const_storage object.
         /// @param storage the memory buffer to use
         storage_reader(const sak::const_storage &storage)
-            : m_storage(storage)
+            : m_data(storage.m_data),
+              m_size(storage.m_size)
+        {
+            assert(m_size > 0);
+            assert(m_data != 0);
+        }
+
+        /// Creates a new storage reader using a memory buffer which may
+        /// be larger than a sak::const_storage can describe.
+        /// @param data the memory buffer to use
+        /// @param size the size of the memory buffer in bytes
+        storage_reader(const uint8_t *data, uint64_t size)
+            : m_data(data),
+              m_size(size)
         {
-            assert(m_storage.m_size > 0);
-            assert(m_storage.m_data != 0);
+            assert(m_size > 0);
+            assert(m_data != 0);
         }
 
         /// @return the size of the storage object in bytes
-        uint32_t size() const
+        uint64_t size() const
         {
-            return m_storage.m_size;
+            return m_size;
         }
 
         /// Initializes the encoder with data from the storage object.
         /// @param encoder to be initialized
         /// @param offset in bytes into the storage object
         /// @param size the number of bytes to use
-        void read(pointer &encoder, uint32_t offset, uint32_t size)
+        void read(pointer &encoder, uint64_t offset, uint32_t size)
         {
             assert(encoder);
-            assert(offset < m_storage.m_size);
+            assert(offset < m_size);
             assert(size > 0);
 
-            uint32_t remaining_bytes = m_storage.m_size - offset;
+            uint64_t remaining_bytes = m_size - offset;
 
             assert(size <= remaining_bytes);
 
-            sak::const_storage storage;
-            storage.m_data = m_storage.m_data + offset;
-            storage.m_size = size;
-
-            encoder->set_symbols(storage);
+            encoder->set_symbols(sak::storage(m_data + offset, size));
 
             // We require that encoders includes the has_bytes_used
             // layer to support partially filled encoders
@@ -74,7 +86,10 @@ namespace kodo
     private:
 
         /// The memory buffer
-        sak::const_storage m_storage;
+        const uint8_t *m_data;
+
+        /// The size of the memory buffer in bytes
+        uint64_t m_size;
 
     };
 
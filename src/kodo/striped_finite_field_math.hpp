@@ -0,0 +1,303 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include <sak/aligned_allocator.hpp>
+
+#include "thread_pool.hpp"
+
+namespace kodo
+{
+
+    /// @ingroup finite_field_layers
+    /// @brief Splits the finite field operations on large buffers into
+    ///        stripes processed by the threads of a thread_pool.
+    ///
+    /// The layer is inserted directly above the finite_field_math layer
+    /// and is intended for very large symbols (64 KB and above) where a
+    /// single row operation in the encoder or decoder takes long enough
+    /// to be worth splitting. The elements of a buffer are independent
+    /// so each thread processes its own range of the buffer. Operations
+    /// on fewer than two stripes worth of data, which includes the
+    /// coding coefficient vectors, are passed directly to the
+    /// finite_field_math layer on the calling thread. Until a pool is
+    /// set with set_math_thread_pool() all operations are passed through.
+    ///
+    /// The multiply_add() and multiply_subtract() of the finite_field_math
+    /// layer share a temporary buffer and cannot be called concurrently,
+    /// so the stripes multiply into their own part of a scratch buffer
+    /// before adding or subtracting.
+    template<class SuperCoder>
+    class striped_finite_field_math : public SuperCoder
+    {
+    public:
+
+        /// @copydoc layer::field_type
+        typedef typename SuperCoder::field_type field_type;
+
+        /// @copydoc layer::value_type
+        typedef typename SuperCoder::value_type value_type;
+
+        /// Pointer to the thread pool
+        typedef boost::shared_ptr<thread_pool> thread_pool_pointer;
+
+        /// The smallest stripe in bytes given to a thread
+        static const uint32_t min_stripe_size = 16384;
+
+    public:
+
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory &the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_scratch.resize(fifi::size_to_length<field_type>(
+                                 the_factory.max_symbol_size()));
+        }
+
+        /// Sets the thread pool used to process the stripes. The pool may
+        /// be shared between coders.
+        /// @param pool The thread pool or a null pointer to perform all
+        ///        operations on the calling thread
+        void set_math_thread_pool(const thread_pool_pointer &pool)
+        {
+            m_thread_pool = pool;
+        }
+
+        /// @return The thread pool used to process the stripes, or a null
+        ///         pointer if none is set
+        const thread_pool_pointer& get_math_thread_pool() const
+        {
+            return m_thread_pool;
+        }
+
+        /// @copydoc layer::multiply(value_type*,value_type,uint32_t)
+        void multiply(value_type *symbol_dest, value_type coefficient,
+                      uint32_t symbol_length)
+        {
+            uint32_t stripes = stripe_count(symbol_length);
+
+            if(stripes <= 1)
+            {
+                SuperCoder::multiply(symbol_dest, coefficient, symbol_length);
+                return;
+            }
+
+            run_striped(stripes, symbol_length,
+                        [=](uint32_t offset, uint32_t length)
+            {
+                SuperCoder::multiply(
+                    symbol_dest + offset, coefficient, length);
+            });
+        }
+
+        /// @copydoc layer::multipy_add(value_type *, const value_type*,
+        ///                             value_type, uint32_t)
+        void multiply_add(value_type *symbol_dest,
+                          const value_type *symbol_src,
+                          value_type coefficient, uint32_t symbol_length)
+        {
+            uint32_t stripes = stripe_count(symbol_length);
+
+            if(stripes <= 1)
+            {
+                SuperCoder::multiply_add(
+                    symbol_dest, symbol_src, coefficient, symbol_length);
+                return;
+            }
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                if(coefficient)
+                {
+                    add(symbol_dest, symbol_src, symbol_length);
+                }
+                return;
+            }
+
+            run_striped(stripes, symbol_length,
+                        [=](uint32_t offset, uint32_t length)
+            {
+                value_type *scratch = multiply_scratch(
+                    symbol_src, coefficient, offset, length);
+
+                SuperCoder::add(symbol_dest + offset, scratch, length);
+            });
+        }
+
+        /// @copydoc layer::add(value_type*, const value_type *, uint32_t)
+        void add(value_type *symbol_dest, const value_type *symbol_src,
+                 uint32_t symbol_length)
+        {
+            uint32_t stripes = stripe_count(symbol_length);
+
+            if(stripes <= 1)
+            {
+                SuperCoder::add(symbol_dest, symbol_src, symbol_length);
+                return;
+            }
+
+            run_striped(stripes, symbol_length,
+                        [=](uint32_t offset, uint32_t length)
+            {
+                SuperCoder::add(
+                    symbol_dest + offset, symbol_src + offset, length);
+            });
+        }
+
+        /// @copydoc layer::multiply_subtract(
+        ///              value_type*, const value_type*,
+        ///              value_type, uint32_t)
+        void multiply_subtract(value_type *symbol_dest,
+                               const value_type *symbol_src,
+                               value_type coefficient,
+                               uint32_t symbol_length)
+        {
+            uint32_t stripes = stripe_count(symbol_length);
+
+            if(stripes <= 1)
+            {
+                SuperCoder::multiply_subtract(
+                    symbol_dest, symbol_src, coefficient, symbol_length);
+                return;
+            }
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                if(coefficient)
+                {
+                    subtract(symbol_dest, symbol_src, symbol_length);
+                }
+                return;
+            }
+
+            run_striped(stripes, symbol_length,
+                        [=](uint32_t offset, uint32_t length)
+            {
+                value_type *scratch = multiply_scratch(
+                    symbol_src, coefficient, offset, length);
+
+                SuperCoder::subtract(symbol_dest + offset, scratch, length);
+            });
+        }
+
+        /// @copydoc layer::subtract(
+        ///              value_type*,const value_type*, uint32_t)
+        void subtract(value_type *symbol_dest, const value_type *symbol_src,
+                      uint32_t symbol_length)
+        {
+            uint32_t stripes = stripe_count(symbol_length);
+
+            if(stripes <= 1)
+            {
+                SuperCoder::subtract(symbol_dest, symbol_src, symbol_length);
+                return;
+            }
+
+            run_striped(stripes, symbol_length,
+                        [=](uint32_t offset, uint32_t length)
+            {
+                SuperCoder::subtract(
+                    symbol_dest + offset, symbol_src + offset, length);
+            });
+        }
+
+    protected:
+
+        /// @param symbol_length The length of the buffer in elements
+        /// @return The number of stripes the buffer should be split into,
+        ///         one or less means the operation is not split
+        uint32_t stripe_count(uint32_t symbol_length) const
+        {
+            if(!m_thread_pool || symbol_length > m_scratch.size())
+            {
+                return 1;
+            }
+
+            uint32_t size =
+                fifi::length_to_size<field_type>(symbol_length);
+
+            return std::min(m_thread_pool->threads(), size / min_stripe_size);
+        }
+
+        /// Runs a function on stripes of a buffer, each stripe a multiple
+        /// of 16 bytes except the last one
+        /// @param stripes The number of stripes wanted
+        /// @param symbol_length The length of the buffer in elements
+        /// @param function The function invoked with the offset and
+        ///        length of each stripe in elements
+        template<class Function>
+        void run_striped(uint32_t stripes, uint32_t symbol_length,
+                         const Function &function)
+        {
+            assert(m_thread_pool);
+            assert(stripes > 1);
+
+            uint32_t alignment = fifi::size_to_length<field_type>(16);
+
+            uint32_t stripe_length = (symbol_length + stripes - 1) / stripes;
+            stripe_length = ((stripe_length + alignment - 1) / alignment) *
+                alignment;
+
+            stripes = (symbol_length + stripe_length - 1) / stripe_length;
+
+            m_thread_pool->run(stripes, [&](uint32_t stripe)
+            {
+                uint32_t offset = stripe * stripe_length;
+                uint32_t length =
+                    std::min(stripe_length, symbol_length - offset);
+
+                function(offset, length);
+            });
+        }
+
+        /// Multiplies a stripe of a buffer into the same stripe of the
+        /// scratch buffer
+        /// @param symbol_src The buffer
+        /// @param coefficient The constant to multiply with
+        /// @param offset The first element of the stripe
+        /// @param length The number of elements in the stripe
+        /// @return The scratch stripe holding the result
+        value_type* multiply_scratch(const value_type *symbol_src,
+                                     value_type coefficient,
+                                     uint32_t offset, uint32_t length)
+        {
+            value_type *scratch = &m_scratch[offset];
+
+            std::copy(symbol_src + offset,
+                      symbol_src + offset + length, scratch);
+
+            SuperCoder::multiply(scratch, coefficient, length);
+
+            return scratch;
+        }
+
+    private:
+
+        /// The aligned storage type for field elements
+        typedef std::vector<value_type, sak::aligned_allocator<value_type> >
+            aligned_value_vector;
+
+        /// Scratch space for the striped multiplications
+        aligned_value_vector m_scratch;
+
+        /// The thread pool used to process the stripes
+        thread_pool_pointer m_thread_pool;
+
+    };
+
+}
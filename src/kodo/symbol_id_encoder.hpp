@@ -5,6 +5,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
+#include <sak/storage.hpp>
+#include <sak/aligned_allocator.hpp>
+
+#include "padded_size.hpp"
+
 namespace kodo
 {
 
@@ -59,12 +67,69 @@ namespace kodo
             return bytes_used;
         }
 
+        /// Writes the symbol ids of all symbols in the batch. The
+        /// coefficients are copied to an aligned buffer per symbol
+        /// since the Symbol ID layer may reuse its coefficient buffer
+        /// between calls to layer::write_id(). The symbol_header array
+        /// is overwritten with pointers to the coefficients before the
+        /// batch is passed to layer::encode_symbols().
+        ///
+        /// @copydoc layer::encode_batch(uint8_t**,uint8_t**,uint32_t*,
+        ///                              uint32_t)
+        void encode_batch(uint8_t **symbol_data, uint8_t **symbol_header,
+                          uint32_t *bytes_used, uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+            assert(bytes_used != 0);
+
+            uint32_t coefficients_size = SuperCoder::coefficients_size();
+            uint32_t stride = padded_size(coefficients_size);
+
+            if(m_batch_coefficients.size() < count * stride)
+            {
+                m_batch_coefficients.resize(count * stride);
+            }
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(symbol_data[k] != 0);
+                assert(symbol_header[k] != 0);
+
+                uint8_t *coefficients = 0;
+
+                bytes_used[k] =
+                    SuperCoder::write_id(symbol_header[k], &coefficients);
+
+                assert(coefficients != 0);
+
+                auto src = sak::storage(coefficients, coefficients_size);
+                auto dest = sak::storage(
+                    &m_batch_coefficients[k * stride], coefficients_size);
+
+                sak::copy_storage(dest, src);
+
+                symbol_header[k] = &m_batch_coefficients[k * stride];
+            }
+
+            SuperCoder::encode_symbols(symbol_data, symbol_header, count);
+        }
+
         /// @copydoc layer::header_size() const
         uint32_t header_size() const
         {
             return SuperCoder::id_size();
         }
 
+    private:
+
+        /// The storage type
+        typedef std::vector<uint8_t, sak::aligned_allocator<uint8_t> >
+            aligned_vector;
+
+        /// Holds the coefficients of the symbols in a batch
+        aligned_vector m_batch_coefficients;
+
     };
 
 }
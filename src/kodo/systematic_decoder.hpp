@@ -87,6 +87,52 @@ namespace kodo
             }
         }
 
+        /// Decodes the systematic symbols of the batch directly and
+        /// passes the remaining encoded symbols on as one batch. The
+        /// encoded symbols are moved to the front of the arrays.
+        ///
+        /// @copydoc layer::decode_batch(uint8_t**,uint8_t**,uint32_t)
+        void decode_batch(uint8_t **symbol_data, uint8_t **symbol_header,
+                          uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+
+            uint32_t encoded = 0;
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(symbol_data[k] != 0);
+                assert(symbol_header[k] != 0);
+
+                uint8_t *header = symbol_header[k];
+
+                flag_type flag =
+                    sak::big_endian::get<flag_type>(header);
+
+                header += sizeof(flag_type);
+
+                if(flag == systematic_base_coder::systematic_flag)
+                {
+                    counter_type symbol_index =
+                        sak::big_endian::get<counter_type>(header);
+
+                    SuperCoder::decode_symbol(symbol_data[k], symbol_index);
+                }
+                else
+                {
+                    symbol_data[encoded] = symbol_data[k];
+                    symbol_header[encoded] = header;
+                    ++encoded;
+                }
+            }
+
+            if(encoded > 0)
+            {
+                SuperCoder::decode_batch(symbol_data, symbol_header, encoded);
+            }
+        }
+
         /// @copydoc layer::header_size() const
         uint32_t header_size() const
         {
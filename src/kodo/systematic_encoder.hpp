@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include <sak/convert_endian.hpp>
 #include <sak/storage.hpp>
@@ -110,6 +111,68 @@ namespace kodo
             }
         }
 
+        /// Encodes the systematic symbols of the batch directly and
+        /// passes the remaining symbols on as a batch. The symbol_data
+        /// and symbol_header arrays are compacted in place.
+        ///
+        /// @copydoc layer::encode_batch(uint8_t**,uint8_t**,uint32_t*,
+        ///                              uint32_t)
+        void encode_batch(uint8_t **symbol_data, uint8_t **symbol_header,
+                          uint32_t *bytes_used, uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(symbol_header != 0);
+            assert(bytes_used != 0);
+
+            m_batch_index.resize(count);
+            m_batch_bytes.resize(count);
+
+            uint32_t encoded = 0;
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(symbol_data[k] != 0);
+                assert(symbol_header[k] != 0);
+
+                bool in_systematic_phase =
+                    m_systematic_count < SuperCoder::rank();
+
+                if(m_systematic && in_systematic_phase)
+                {
+                    bytes_used[k] =
+                        encode_systematic(symbol_data[k], symbol_header[k]);
+                }
+                else
+                {
+                    /// Flag non_systematic packet
+                    sak::big_endian::put<flag_type>(
+                        systematic_base_coder::non_systematic_flag,
+                        symbol_header[k]);
+
+                    symbol_data[encoded] = symbol_data[k];
+                    symbol_header[encoded] =
+                        symbol_header[k] + sizeof(flag_type);
+
+                    m_batch_index[encoded] = k;
+                    ++encoded;
+                }
+            }
+
+            if(encoded == 0)
+            {
+                return;
+            }
+
+            SuperCoder::encode_batch(
+                symbol_data, symbol_header, &m_batch_bytes[0], encoded);
+
+            for(uint32_t k = 0; k < encoded; ++k)
+            {
+                bytes_used[m_batch_index[k]] =
+                    m_batch_bytes[k] + sizeof(flag_type);
+            }
+        }
+
         /// @return, true if the encoder is in systematic mode
         bool is_systematic_on() const
         {
@@ -195,6 +258,12 @@ namespace kodo
         /// Counts the number of systematic packets produced
         uint32_t m_systematic_count;
 
+        /// The position in the batch of the non-systematic symbols
+        std::vector<uint32_t> m_batch_index;
+
+        /// The bytes used by the non-systematic symbols of a batch
+        std::vector<uint32_t> m_batch_bytes;
+
     };
 
     template<class SuperCoder>
@@ -0,0 +1,282 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace kodo
+{
+
+    /// @brief Persistent pool of worker threads used to split a single
+    ///        coding operation into independent tasks.
+    ///
+    /// The workers are started when the pool is created and sleep
+    /// between runs, so the cost of a run is a wake-up rather than a
+    /// thread creation. The thread calling run() takes part in the work,
+    /// a pool created with a single thread therefore runs all tasks on
+    /// the calling thread. A pool may be shared by several coders,
+    /// concurrent calls to run() are serialized and a run() started from
+    /// within a task executes its tasks on the calling thread.
+    ///
+    /// If a task throws, the tasks not yet started are skipped and the
+    /// first exception is rethrown from run() once all threads have
+    /// left the run.
+    class thread_pool : boost::noncopyable
+    {
+    public:
+
+        /// The function type invoked for every task
+        typedef std::function<void (uint32_t)> task_function;
+
+    public:
+
+        /// Constructor
+        /// @param threads The number of threads executing tasks including
+        ///        the thread calling run()
+        explicit thread_pool(uint32_t threads)
+            : m_threads(threads),
+              m_caller(std::thread::id()),
+              m_job(0),
+              m_tasks(0),
+              m_next(0),
+              m_active(0),
+              m_generation(0),
+              m_stop(false)
+        {
+            assert(m_threads > 0);
+
+            for(uint32_t i = 1; i < m_threads; ++i)
+            {
+                m_workers.push_back(
+                    std::thread(&thread_pool::worker_loop, this));
+            }
+        }
+
+        /// Destructor, stops and joins the workers
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_start.notify_all();
+
+            for(uint32_t i = 0; i < m_workers.size(); ++i)
+            {
+                m_workers[i].join();
+            }
+        }
+
+        /// @return The number of threads executing tasks including the
+        ///         thread calling run()
+        uint32_t threads() const
+        {
+            return m_threads;
+        }
+
+        /// Invokes the job once for every task in [0, tasks) and returns
+        /// when all tasks have completed. The tasks may run in any order
+        /// and concurrently. The first exception thrown by a task is
+        /// rethrown after all threads have stopped executing the job.
+        /// @param tasks The number of tasks
+        /// @param job The function invoked with the index of each task
+        void run(uint32_t tasks, const task_function &job)
+        {
+            if(m_workers.empty() || tasks <= 1 || in_task())
+            {
+                for(uint32_t i = 0; i < tasks; ++i)
+                {
+                    job(i);
+                }
+                return;
+            }
+
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+
+            m_caller = std::this_thread::get_id();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                m_job = &job;
+                m_tasks = tasks;
+                m_next = 0;
+                m_active = static_cast<uint32_t>(m_workers.size());
+                ++m_generation;
+            }
+
+            m_start.notify_all();
+
+            work();
+
+            std::exception_ptr error;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                while(m_active > 0)
+                {
+                    m_done.wait(lock);
+                }
+
+                m_job = 0;
+                m_caller = std::thread::id();
+
+                error = m_error;
+                m_error = std::exception_ptr();
+            }
+
+            if(error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+
+        /// @return True if the calling thread is executing a task of
+        ///         this pool
+        bool in_task() const
+        {
+            std::thread::id id = std::this_thread::get_id();
+
+            if(m_caller == id)
+            {
+                return true;
+            }
+
+            for(uint32_t i = 0; i < m_workers.size(); ++i)
+            {
+                if(m_workers[i].get_id() == id)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Executes tasks of the current run until none are left. An
+        /// exception thrown by a task is stored and the remaining tasks
+        /// are skipped.
+        void work()
+        {
+            assert(m_job != 0);
+
+            try
+            {
+                for(uint32_t task = m_next++; task < m_tasks;
+                    task = m_next++)
+                {
+                    (*m_job)(task);
+                }
+            }
+            catch(...)
+            {
+                // Tasks not yet started are skipped by all threads
+                m_next = m_tasks;
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                if(!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+
+        /// The function executed by every worker thread
+        void worker_loop()
+        {
+            uint64_t generation = 0;
+
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+
+                    while(!m_stop && m_generation == generation)
+                    {
+                        m_start.wait(lock);
+                    }
+
+                    if(m_stop)
+                    {
+                        return;
+                    }
+
+                    generation = m_generation;
+                }
+
+                work();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                if(--m_active == 0)
+                {
+                    m_done.notify_one();
+                }
+            }
+        }
+
+    private:
+
+        /// The number of threads executing tasks
+        uint32_t m_threads;
+
+        /// The worker threads
+        std::vector<std::thread> m_workers;
+
+        /// Serializes concurrent calls to run()
+        std::mutex m_run_mutex;
+
+        /// The thread executing the current run()
+        std::atomic<std::thread::id> m_caller;
+
+        /// Protects the state shared with the workers
+        std::mutex m_mutex;
+
+        /// Signals the workers that a run has started or the pool stops
+        std::condition_variable m_start;
+
+        /// Signals the caller of run() that the workers are done
+        std::condition_variable m_done;
+
+        /// The job of the current run
+        const task_function *m_job;
+
+        /// The number of tasks in the current run
+        uint32_t m_tasks;
+
+        /// The next task to be executed
+        std::atomic<uint32_t> m_next;
+
+        /// The number of workers still working on the current run
+        uint32_t m_active;
+
+        /// The first exception thrown by a task of the current run
+        std::exception_ptr m_error;
+
+        /// Incremented for every run so the workers can detect it
+        uint64_t m_generation;
+
+        /// True when the pool is being destroyed
+        bool m_stop;
+
+    };
+
+}
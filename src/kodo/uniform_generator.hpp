@@ -7,17 +7,29 @@
 
 #include <cstdint>
 
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 
+#include <fifi/is_binary.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include "pivot_bitmap.hpp"
+#include "mt19937_generator_policy.hpp"
+#include "xoshiro256_generator_policy.hpp"
+
 namespace kodo
 {
 
     /// @ingroup coefficient_generator_layers
     /// @brief Generates an uniform random coefficient (from the chosen
-    /// Finite Field) for every symbol.
-    template<class SuperCoder>
-    class uniform_generator : public SuperCoder
+    /// Finite Field) for every symbol using the random generator given
+    /// by the GeneratorPolicy.
+    ///
+    /// The coefficient vectors are filled by the fill() function of
+    /// the policy, which lets a generator produce several bytes per
+    /// step. See the mt19937_generator_policy for the functions a
+    /// policy must provide.
+    template<class GeneratorPolicy, class SuperCoder>
+    class basic_uniform_generator : public SuperCoder
     {
     public:
 
@@ -28,17 +40,16 @@ namespace kodo
         typedef typename SuperCoder::value_type value_type;
 
         /// The random generator used
-        typedef boost::random::mt19937 generator_type;
+        typedef GeneratorPolicy generator_type;
 
         /// @copydoc layer::seed_type
-        typedef generator_type::result_type seed_type;
+        typedef typename generator_type::seed_type seed_type;
 
     public:
 
         /// Constructor
-        uniform_generator()
-            : m_distribution(),
-              m_value_distribution(field_type::min_value,
+        basic_uniform_generator()
+            : m_value_distribution(field_type::min_value,
                                    field_type::max_value)
         { }
 
@@ -47,34 +58,38 @@ namespace kodo
         {
             assert(coefficients != 0);
 
-            uint32_t size = SuperCoder::coefficients_size();
-            for(uint32_t i = 0; i < size; ++i)
-            {
-                coefficients[i] = m_distribution(m_random_generator);
-            }
+            m_random_generator.fill(
+                coefficients, SuperCoder::coefficients_size());
         }
 
-        /// @copydoc layer::generate(uint8_t*)
+        /// @copydoc layer::generate_partial(uint8_t*)
         void generate_partial(uint8_t *coefficients)
         {
             assert(coefficients != 0);
 
+            const pivot_bitmap &pivots = SuperCoder::symbol_pivots();
+
+            value_type *c = reinterpret_cast<value_type*>(coefficients);
+
+            if(fifi::is_binary<field_type>::value)
+            {
+                // Draw random bits for all symbols and clear the ones
+                // of the symbols not available
+                generate(coefficients);
+                pivots.template mask<field_type>(c);
+                return;
+            }
+
             // Since we will not set all coefficients we should ensure
             // that the non specified ones are zero
             std::fill_n(
                 coefficients, SuperCoder::coefficients_size(), 0);
 
-            value_type *c = reinterpret_cast<value_type*>(coefficients);
-
             uint32_t symbols = SuperCoder::symbols();
 
-            for(uint32_t i = 0; i < symbols; ++i)
+            for(uint32_t i = pivots.find_next(0); i < symbols;
+                i = pivots.find_next(i + 1))
             {
-                if(!SuperCoder::symbol_pivot(i))
-                {
-                    continue;
-                }
-
                 value_type coefficient =
                     m_value_distribution(m_random_generator);
 
@@ -90,13 +105,6 @@ namespace kodo
 
     private:
 
-        /// The type of the uint8_t distribution
-        typedef boost::random::uniform_int_distribution<uint8_t>
-        uint8_t_distribution;
-
-        /// Distribution that generates random bytes
-        uint8_t_distribution m_distribution;
-
         /// The type of the value_type distribution
         typedef boost::random::uniform_int_distribution<value_type>
         value_type_distribution;
@@ -105,9 +113,30 @@ namespace kodo
         value_type_distribution m_value_distribution;
 
         /// The random generator
-        boost::random::mt19937 m_random_generator;
+        generator_type m_random_generator;
 
     };
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Uniform coefficient generator using the
+    /// mt19937_generator_policy.
+    ///
+    /// This generator is used by the seed codes since the coefficients
+    /// generated from a seed are part of their wire format.
+    template<class SuperCoder>
+    class uniform_generator : public
+        basic_uniform_generator<mt19937_generator_policy, SuperCoder>
+    { };
+
+    /// @ingroup coefficient_generator_layers
+    /// @brief Uniform coefficient generator using the
+    /// xoshiro256_generator_policy, which produces 8 random bytes per
+    /// step and is cheap to seed.
+    template<class SuperCoder>
+    class fast_uniform_generator : public
+        basic_uniform_generator<xoshiro256_generator_policy, SuperCoder>
+    { };
+
 }
 
 
@@ -0,0 +1,155 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodo
+{
+
+    /// @brief Random generator policy for the coefficient generators
+    ///        based on the xoshiro256** generator.
+    ///
+    /// Every step of the generator produces 64 random bits using a few
+    /// shifts, rotations and xors, and fill() writes all 8 bytes of a
+    /// step to the buffer. Seeding expands the seed into the 256 bit
+    /// state using the splitmix64 generator, which makes reseeding for
+    /// every coefficient vector cheap. The bytes are written in little
+    /// endian order so a seed produces the same coefficients on all
+    /// platforms.
+    ///
+    /// The policy models the boost UniformRandomNumberGenerator concept.
+    ///
+    /// @see mt19937_generator_policy
+    class xoshiro256_generator_policy
+    {
+    public:
+
+        /// The type of the values produced
+        typedef uint64_t result_type;
+
+        /// The type of the seed
+        typedef uint32_t seed_type;
+
+        /// The version of the seeds written by the seed codes using
+        /// this policy, see seed_symbol_id
+        static const uint8_t seed_version = 2;
+
+    public:
+
+        /// Constructor
+        xoshiro256_generator_policy()
+        {
+            seed(0);
+        }
+
+        /// Seeds the generator
+        /// @param seed_value The seed
+        void seed(seed_type seed_value)
+        {
+            uint64_t x = seed_value;
+
+            for(uint32_t i = 0; i < 4; ++i)
+            {
+                m_state[i] = splitmix64(x);
+            }
+        }
+
+        /// Fills a buffer with uniformly distributed random bytes
+        /// @param data The buffer
+        /// @param size The size of the buffer in bytes
+        void fill(uint8_t *data, uint32_t size)
+        {
+            assert(data != 0);
+
+            uint32_t i = 0;
+
+            for(; i + 8 <= size; i += 8)
+            {
+                uint64_t value = next();
+
+                for(uint32_t j = 0; j < 8; ++j)
+                {
+                    data[i + j] = uint8_t(value >> (8 * j));
+                }
+            }
+
+            if(i < size)
+            {
+                uint64_t value = next();
+
+                for(uint32_t j = 0; i + j < size; ++j)
+                {
+                    data[i + j] = uint8_t(value >> (8 * j));
+                }
+            }
+        }
+
+        /// @return The next random value
+        result_type operator()()
+        {
+            return next();
+        }
+
+        /// @return The smallest value produced
+        static result_type min()
+        {
+            return 0;
+        }
+
+        /// @return The largest value produced
+        static result_type max()
+        {
+            return ~result_type(0);
+        }
+
+    private:
+
+        /// @return The next 64 random bits
+        uint64_t next()
+        {
+            uint64_t result = rotate_left(m_state[1] * 5, 7) * 9;
+            uint64_t t = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+
+            m_state[2] ^= t;
+            m_state[3] = rotate_left(m_state[3], 45);
+
+            return result;
+        }
+
+        /// @param x The value to rotate
+        /// @param k The number of bits to rotate by
+        /// @return The value rotated k bits to the left
+        static uint64_t rotate_left(uint64_t x, uint32_t k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        /// Advances the splitmix64 generator used for seeding
+        /// @param x The state of the splitmix64 generator
+        /// @return The next value of the splitmix64 generator
+        static uint64_t splitmix64(uint64_t &x)
+        {
+            uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+
+        /// The state of the generator
+        uint64_t m_state[4];
+
+    };
+
+}
@@ -5,13 +5,20 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstdint>
+#include <algorithm>
 
 namespace kodo
 {
 
     /// @ingroup codec_layers
     /// @brief Zeros the symbol data buffer
+    ///
+    /// @deprecated The linear_block_encoder overwrites the symbol data
+    /// buffer with the first term of the encoded symbol so this layer is
+    /// not needed in stacks using it, where it only costs a memset. It
+    /// is kept for encoders which accumulate into the buffer.
     template<class SuperCoder>
     class zero_symbol_encoder : public SuperCoder
     {
@@ -41,6 +48,40 @@ namespace kodo
             SuperCoder::encode_symbol(symbol_data, symbol_index);
         }
 
+        /// Zero the incoming symbol data buffer and forward the
+        /// encode_sparse_symbol() call.
+        ///
+        /// @copydoc layer::encode_sparse_symbol(uint8_t*, uint8_t*,
+        ///                                      const uint32_t*, uint32_t)
+        void encode_sparse_symbol(uint8_t *symbol_data, uint8_t *coefficients,
+                                  const uint32_t *positions, uint32_t count)
+        {
+            assert(symbol_data != 0);
+
+            std::fill_n(symbol_data, SuperCoder::symbol_size(), 0);
+            SuperCoder::encode_sparse_symbol(
+                symbol_data, coefficients, positions, count);
+        }
+
+        /// Zero the symbol data buffers of the batch and forward the
+        /// encode_symbols() call.
+        ///
+        /// @copydoc layer::encode_symbols(uint8_t**,uint8_t**,uint32_t)
+        void encode_symbols(uint8_t **symbol_data, uint8_t **coefficients,
+                            uint32_t count)
+        {
+            assert(symbol_data != 0);
+            assert(coefficients != 0);
+
+            for(uint32_t k = 0; k < count; ++k)
+            {
+                assert(symbol_data[k] != 0);
+                std::fill_n(symbol_data[k], SuperCoder::symbol_size(), 0);
+            }
+
+            SuperCoder::encode_symbols(symbol_data, coefficients, count);
+        }
+
     };
 
 }
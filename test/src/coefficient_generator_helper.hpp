@@ -20,6 +20,7 @@
 #include <kodo/uniform_generator.hpp>
 #include <kodo/sparse_uniform_generator.hpp>
 #include <kodo/fake_symbol_storage.hpp>
+#include <kodo/pivot_bitmap.hpp>
 
 #include "basic_api_test_helper.hpp"
 
@@ -40,6 +41,15 @@ namespace kodo
     {
     public:
 
+        /// @copydoc layer::construct(Factory&)
+        template<class Factory>
+        void construct(Factory& the_factory)
+        {
+            SuperCoder::construct(the_factory);
+
+            m_pivot.resize(the_factory.max_symbols());
+        }
+
         /// @copydoc layer::initialize(Factory&)
         template<class Factory>
         void initialize(Factory& the_factory)
@@ -47,13 +57,15 @@ namespace kodo
             SuperCoder::initialize(the_factory);
 
             m_pivots = 0;
-            m_pivot.resize(the_factory.symbols());
+            m_pivot.reset(the_factory.symbols());
 
             for(uint32_t i = 0; i < m_pivot.size(); ++i)
             {
-                m_pivot[i] = rand() % 2;
-                if(m_pivot[i])
+                if(rand() % 2)
+                {
+                    m_pivot.set(i);
                     ++m_pivots;
+                }
             }
         }
 
@@ -70,10 +82,16 @@ namespace kodo
             return m_pivot[index];
         }
 
+        /// @copydoc layer::symbol_pivots() const
+        const pivot_bitmap& symbol_pivots() const
+        {
+            return m_pivot;
+        }
+
     private:
 
         /// Track dummy pivot
-        std::vector<bool> m_pivot;
+        pivot_bitmap m_pivot;
 
         /// The number of pivots
         uint32_t m_pivots;
@@ -0,0 +1,114 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/default_field.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include <kodo/thread_pool.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Decodes a mix of uncoded symbols and random binary combinations of
+/// the original symbols and checks that the decoded symbols match the
+/// original ones. The decoder stack must use the binary field.
+/// @param symbols The number of symbols
+/// @param symbol_size The size of a symbol in bytes
+/// @param pool The thread pool given to the decoder, may be null
+template<template <class> class Stack>
+inline void test_decode_binary_combinations(
+    uint32_t symbols, uint32_t symbol_size,
+    const boost::shared_ptr<kodo::thread_pool> &pool =
+        boost::shared_ptr<kodo::thread_pool>())
+{
+    typedef fifi::binary field_type;
+    typedef typename Stack<field_type>::factory factory_type;
+
+    factory_type factory(symbols, symbol_size);
+    auto decoder = factory.build();
+
+    decoder->set_thread_pool(pool);
+
+    std::vector<std::vector<uint8_t> > original(symbols);
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        original[i] = random_vector(symbol_size);
+    }
+
+    // Give the decoder every fifth symbol uncoded
+    for(uint32_t i = 0; i < symbols; i += 5)
+    {
+        std::vector<uint8_t> symbol = original[i];
+        decoder->decode_symbol(&symbol[0], i);
+    }
+
+    std::vector<uint8_t> coefficients(decoder->coefficients_size());
+    std::vector<uint8_t> symbol(symbol_size);
+
+    while(!decoder->is_complete())
+    {
+        std::fill(coefficients.begin(), coefficients.end(), 0);
+        std::fill(symbol.begin(), symbol.end(), 0);
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            if(rand() % 2 == 0)
+            {
+                continue;
+            }
+
+            fifi::set_value<field_type>(&coefficients[0], i, 1U);
+
+            for(uint32_t j = 0; j < symbol_size; ++j)
+            {
+                symbol[j] ^= original[i][j];
+            }
+        }
+
+        decoder->decode_symbol(&symbol[0], &coefficients[0]);
+    }
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        const uint8_t *decoded = decoder->symbol(i);
+
+        EXPECT_TRUE(std::equal(original[i].begin(), original[i].end(),
+                               decoded)) << "symbol " << i;
+    }
+}
+
+/// Runs test_decode_binary_combinations() with generation sizes
+/// covering a single partial group up to many groups of pivots, with
+/// and without a thread pool splitting the symbol data
+template<template <class> class Stack>
+inline void test_decode_binary_combinations()
+{
+    test_decode_binary_combinations<Stack>(1, 16);
+    test_decode_binary_combinations<Stack>(5, 1600);
+    test_decode_binary_combinations<Stack>(64, 100);
+    test_decode_binary_combinations<Stack>(300, 40);
+
+    // Large symbols limit the number of pivots combined in a table
+    test_decode_binary_combinations<Stack>(40, 200000);
+
+    test_decode_binary_combinations<Stack>(
+        rand_symbols(), rand_symbol_size());
+
+    auto pool = boost::make_shared<kodo::thread_pool>(4);
+
+    // Small symbols are not split between the threads
+    test_decode_binary_combinations<Stack>(20, 100, pool);
+
+    // The last stripe is shorter than the others
+    test_decode_binary_combinations<Stack>(40, 65540, pool);
+    test_decode_binary_combinations<Stack>(7, 9000, pool);
+}
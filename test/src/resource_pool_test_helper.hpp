@@ -0,0 +1,93 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file resource_pool_test_helper.hpp Helpers shared by the unit tests
+///       of the resource pools
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace
+{
+    /// Resource counting the number of instances alive
+    struct dummy_resource
+    {
+        dummy_resource()
+        {
+            ++count();
+        }
+
+        ~dummy_resource()
+        {
+            --count();
+        }
+
+        static std::atomic<int32_t>& count()
+        {
+            static std::atomic<int32_t> instances(0);
+            return instances;
+        }
+    };
+
+    boost::shared_ptr<dummy_resource> make_dummy()
+    {
+        return boost::make_shared<dummy_resource>();
+    }
+}
+
+/// Tests that the pool can be filled in advance and that the number of
+/// unused resources is limited
+template<class Pool>
+inline void test_reserve_and_max_pooled(Pool &pool)
+{
+    pool.reserve(4);
+
+    EXPECT_EQ(4U, pool.total_resources());
+    EXPECT_EQ(4U, pool.unused_resources());
+    EXPECT_EQ(4U, pool.created_resources());
+    EXPECT_EQ(4, dummy_resource::count().load());
+
+    {
+        std::vector<boost::shared_ptr<dummy_resource> > held;
+
+        for(uint32_t i = 0; i < 6; ++i)
+        {
+            held.push_back(pool.allocate());
+        }
+
+        EXPECT_EQ(4U, pool.recycled_resources());
+        EXPECT_EQ(6U, pool.created_resources());
+        EXPECT_EQ(6U, pool.used_resources());
+
+        pool.set_max_pooled(3);
+        EXPECT_EQ(3U, pool.max_pooled());
+    }
+
+    // The resources released into a full pool are deleted
+    EXPECT_EQ(3U, pool.unused_resources());
+    EXPECT_EQ(3U, pool.total_resources());
+    EXPECT_EQ(6U, pool.total_high_water_mark());
+    EXPECT_EQ(3, dummy_resource::count().load());
+
+    // Lowering the limit deletes unused resources
+    pool.set_max_pooled(1);
+    EXPECT_EQ(1U, pool.unused_resources());
+    EXPECT_EQ(1, dummy_resource::count().load());
+
+    // Reserving stops at the limit
+    pool.reserve(5);
+    EXPECT_EQ(1U, pool.unused_resources());
+
+    pool.free_unused_resources();
+    EXPECT_EQ(0, dummy_resource::count().load());
+}
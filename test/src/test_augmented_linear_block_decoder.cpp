@@ -0,0 +1,154 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_augmented_linear_block_decoder.cpp Unit tests for the
+///       kodo::augmented_linear_block_decoder and the
+///       kodo::augmented_symbol_storage layers
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <sak/is_aligned.hpp>
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/augmented_symbol_storage.hpp>
+#include <kodo/augmented_linear_block_decoder.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+#include "helper_test_reuse_api.hpp"
+#include "helper_test_recoding_api.hpp"
+#include "helper_test_basic_api.hpp"
+#include "helper_test_initialize_api.hpp"
+#include "helper_test_systematic_api.hpp"
+#include "helper_test_mix_uncoded_api.hpp"
+
+namespace kodo
+{
+
+    /// Implementation of a RLNC decoder storing the coefficients
+    /// and symbol data in augmented rows.
+    template<class Field>
+    class full_rlnc_augmented_decoder
+        : public // Payload API
+                 payload_recoder<recoding_stack,
+                 payload_decoder<
+                 // Codec Header API
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 // Symbol ID API
+                 plain_symbol_id_reader<
+                 // Codec API
+                 forward_augmented_linear_block_decoder<
+                 // Coefficient and Symbol Storage API
+                 augmented_symbol_storage<
+                 coefficient_info<
+                 storage_bytes_used<
+                 storage_block_info<
+                 // Finite Field Math API
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 // Factory API
+                 final_coder_factory_pool<
+                 // Final type
+                 full_rlnc_augmented_decoder<Field>
+                     > > > > > > > > > > > > >
+    { };
+
+}
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestAugmentedLinearBlockDecoder, test_basic_api)
+{
+    test_basic_api<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+}
+
+/// Test that the encoders and decoders initialize() function can be used
+/// to reset the state of an encoder and decoder and that they therefore
+/// can be safely reused.
+TEST(TestAugmentedLinearBlockDecoder, test_initialize)
+{
+    test_initialize<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestAugmentedLinearBlockDecoder, test_systematic)
+{
+    test_systematic<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+}
+
+/// Tests whether mixed un-coded and coded packets are correctly handled
+/// in the encoder and decoder.
+TEST(TestAugmentedLinearBlockDecoder, mix_uncoded)
+{
+    test_mix_uncoded<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+}
+
+/// Tests that the decoder can be used to recode
+TEST(TestAugmentedLinearBlockDecoder, test_recoders_api)
+{
+    test_recoders<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+}
+
+/// Tests that the decoders can be safely reused
+TEST(TestAugmentedLinearBlockDecoder, test_reuse_api)
+{
+    test_reuse<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+
+    test_reuse_incomplete<kodo::full_rlnc_encoder,
+        kodo::full_rlnc_augmented_decoder>();
+}
+
+/// Tests the layout of the augmented rows
+TEST(TestAugmentedLinearBlockDecoder, test_augmented_rows)
+{
+    typedef kodo::full_rlnc_augmented_decoder<fifi::binary8> decoder_type;
+
+    decoder_type::factory decoder_factory(20, 100);
+
+    // The coefficients are padded up to the 16 byte alignment
+    EXPECT_EQ(32U + 100U, decoder_factory.max_augmented_size());
+
+    decoder_factory.set_symbols(5);
+    decoder_factory.set_symbol_size(40);
+
+    auto decoder = decoder_factory.build();
+
+    EXPECT_EQ(16U, decoder->augmented_symbol_offset());
+    EXPECT_EQ(16U + 40U, decoder->augmented_size());
+    EXPECT_EQ(16U + 40U, decoder->augmented_length());
+
+    for(uint32_t i = 0; i < decoder->symbols(); ++i)
+    {
+        EXPECT_TRUE(sak::is_aligned(decoder->coefficients(i)));
+        EXPECT_TRUE(sak::is_aligned(decoder->symbol(i)));
+
+        EXPECT_EQ(decoder->coefficients(i) + 16U, decoder->symbol(i));
+        EXPECT_EQ(decoder->coefficients_value(i),
+                  decoder->augmented_value(i));
+    }
+
+    // Decoding an uncoded symbol stores both the unit vector and the
+    // symbol in the same row
+    std::vector<uint8_t> symbol = random_vector(decoder->symbol_size());
+    decoder->decode_symbol(&symbol[0], 3U);
+
+    EXPECT_EQ(1U, decoder->rank());
+    EXPECT_EQ(1U, fifi::get_value<fifi::binary8>(
+                  decoder->coefficients_value(3), 3));
+
+    EXPECT_TRUE(sak::equal(
+                    sak::storage(decoder->symbol(3), decoder->symbol_size()),
+                    sak::storage(symbol)));
+}
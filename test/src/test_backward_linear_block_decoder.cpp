@@ -15,6 +15,7 @@
 #include <kodo/debug_linear_block_decoder.hpp>
 
 #include "basic_api_test_helper.hpp"
+#include "linear_block_decoder_test_helper.hpp"
 
 namespace kodo
 {
@@ -66,7 +67,7 @@ namespace kodo
                  // Factory API
                  final_coder_factory_pool<
                  // Final type
-                 test_backward_stack<Field>
+                 test_backward_delayed_stack<Field>
                      > > > > > > > > > > >
     { };
 
@@ -241,5 +242,9 @@ TEST(TestBackwardLinearBlockDecoder, test_decoder_delayed)
     test_backward_stack<kodo::test_backward_delayed_stack>();
 }
 
-
-
+/// Checks that the binary delayed decoder recovers the original symbols
+/// when the final backward substitution spans several pivot groups
+TEST(TestBackwardLinearBlockDecoder, test_decoder_delayed_binary)
+{
+    test_decode_binary_combinations<kodo::test_backward_delayed_stack>();
+}
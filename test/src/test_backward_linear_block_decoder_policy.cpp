@@ -7,8 +7,12 @@
 ///       for the backward_linear_block_decoder_policy
 
 #include <cstdint>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include <fifi/field_types.hpp>
+
 #include <kodo/backward_linear_block_decoder_policy.hpp>
 
 
@@ -52,5 +56,32 @@ TEST(TestBackwardLinearBlockDecoderPolicy, test_functions)
     }
 }
 
+/// Tests that the policy can skip past zero coefficients
+TEST(TestBackwardLinearBlockDecoderPolicy, test_skip_zeros)
+{
+    typedef kodo::backward_linear_block_decoder_policy policy_type;
+
+    std::vector<uint8_t> coefficients(8, 0);
+    coefficients[3] = 1;
+    coefficients[5] = 7;
+
+    uint32_t start = policy_type::min(0, 7);
+    uint32_t stop = policy_type::max(0, 7);
 
+    policy_type policy(start, stop);
+    policy.skip_zeros<fifi::binary8>(&coefficients[0]);
 
+    EXPECT_FALSE(policy.at_end());
+    EXPECT_EQ(5U, policy.index());
+
+    policy.advance();
+    policy.skip_zeros<fifi::binary8>(&coefficients[0]);
+
+    EXPECT_FALSE(policy.at_end());
+    EXPECT_EQ(3U, policy.index());
+
+    policy.advance();
+    policy.skip_zeros<fifi::binary8>(&coefficients[0]);
+
+    EXPECT_TRUE(policy.at_end());
+}
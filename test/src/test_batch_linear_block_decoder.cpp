@@ -0,0 +1,154 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_batch_linear_block_decoder.cpp Unit tests for the
+///       kodo::batch_linear_block_decoder layer and the decode_batch()
+///       functions of the Payload and Codec Header layers
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/seed_codes.hpp>
+#include <kodo/rlnc/on_the_fly_codes.hpp>
+#include <kodo/systematic_operations.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Decodes bursts of payloads using decode_batch() and checks that
+/// the decoder progresses exactly as a decoder which receives the
+/// same payloads one at a time.
+template<class Encoder, class Decoder>
+inline void test_decode_batch(uint32_t symbols, uint32_t symbol_size,
+                              uint32_t batch_size, bool systematic)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto batch_decoder = decoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    if(systematic)
+    {
+        kodo::set_systematic_on(encoder);
+    }
+    else
+    {
+        kodo::set_systematic_off(encoder);
+    }
+
+    uint32_t payload_size = encoder->payload_size();
+
+    std::vector<uint8_t> batch_payloads(batch_size * payload_size);
+    std::vector<uint8_t> payloads(batch_size * payload_size);
+    std::vector<uint8_t*> batch(batch_size);
+
+    while(!batch_decoder->is_complete())
+    {
+        for(uint32_t k = 0; k < batch_size; ++k)
+        {
+            batch[k] = &batch_payloads[k * payload_size];
+            encoder->encode(batch[k]);
+        }
+
+        payloads = batch_payloads;
+
+        batch_decoder->decode_batch(&batch[0], batch_size);
+
+        for(uint32_t k = 0; k < batch_size; ++k)
+        {
+            decoder->decode(&payloads[k * payload_size]);
+        }
+
+        EXPECT_EQ(decoder->rank(), batch_decoder->rank());
+        EXPECT_EQ(decoder->is_complete(), batch_decoder->is_complete());
+    }
+
+    std::vector<uint8_t> data_out(batch_decoder->block_size(), '\0');
+    batch_decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+template
+<
+    template <class> class Encoder,
+    template <class> class Decoder
+>
+inline void test_decode_batch(uint32_t symbols, uint32_t symbol_size,
+                              uint32_t batch_size)
+{
+    test_decode_batch<Encoder<fifi::binary>, Decoder<fifi::binary> >(
+        symbols, symbol_size, batch_size, false);
+
+    test_decode_batch<Encoder<fifi::binary8>, Decoder<fifi::binary8> >(
+        symbols, symbol_size, batch_size, false);
+
+    test_decode_batch<Encoder<fifi::binary16>, Decoder<fifi::binary16> >(
+        symbols, symbol_size, batch_size, false);
+
+    test_decode_batch<Encoder<fifi::binary8>, Decoder<fifi::binary8> >(
+        symbols, symbol_size, batch_size, true);
+}
+
+template
+<
+    template <class> class Encoder,
+    template <class> class Decoder
+>
+inline void test_decode_batch()
+{
+    test_decode_batch<Encoder, Decoder>(32, 1600, 1);
+    test_decode_batch<Encoder, Decoder>(32, 1600, 8);
+    test_decode_batch<Encoder, Decoder>(1, 1600, 4);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+    uint32_t batch_size = 1 + (rand() % symbols);
+
+    test_decode_batch<Encoder, Decoder>(symbols, symbol_size, batch_size);
+}
+
+/// Tests batch decoding with the full vector RLNC decoder
+TEST(TestBatchLinearBlockDecoder, test_full_rlnc)
+{
+    test_decode_batch<kodo::full_rlnc_encoder, kodo::full_rlnc_decoder>();
+}
+
+/// Tests batch decoding with the seed RLNC decoder, where the
+/// coefficients of every symbol are regenerated into the same buffer
+TEST(TestBatchLinearBlockDecoder, test_seed_rlnc)
+{
+    test_decode_batch<kodo::seed_rlnc_encoder, kodo::seed_rlnc_decoder>();
+}
+
+/// Tests batch decoding with the on-the-fly decoder which also reads
+/// the encoder rank from every payload
+TEST(TestBatchLinearBlockDecoder, test_on_the_fly)
+{
+    test_decode_batch<kodo::on_the_fly_encoder, kodo::on_the_fly_decoder>();
+}
+
+/// Tests that an empty batch does not change the decoder
+TEST(TestBatchLinearBlockDecoder, test_empty_batch)
+{
+    typedef kodo::full_rlnc_decoder<fifi::binary8> decoder_type;
+
+    decoder_type::factory decoder_factory(10, 100);
+    auto decoder = decoder_factory.build();
+
+    uint8_t *payload = 0;
+    decoder->decode_batch(&payload, 0);
+
+    EXPECT_EQ(0U, decoder->rank());
+}
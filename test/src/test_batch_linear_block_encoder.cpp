@@ -0,0 +1,172 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_batch_linear_block_encoder.cpp Unit tests for the
+///       encode_batch() functions of the encoder layers
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/rlnc/seed_codes.hpp>
+#include <kodo/rlnc/on_the_fly_codes.hpp>
+#include <kodo/systematic_operations.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Encodes bursts of payloads using encode_batch() and checks that the
+/// payloads are identical to those of an encoder producing the same
+/// payloads one at a time, and that they decode to the original data.
+template<class Encoder, class Decoder>
+inline void test_encode_batch(uint32_t symbols, uint32_t symbol_size,
+                              uint32_t batch_size, bool systematic)
+{
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto batch_encoder = encoder_factory.build();
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    batch_encoder->set_symbols(sak::storage(data_in));
+    encoder->set_symbols(sak::storage(data_in));
+
+    // Both encoders must draw the same coefficients
+    batch_encoder->seed(42);
+    encoder->seed(42);
+
+    if(systematic)
+    {
+        kodo::set_systematic_on(batch_encoder);
+        kodo::set_systematic_on(encoder);
+    }
+    else
+    {
+        kodo::set_systematic_off(batch_encoder);
+        kodo::set_systematic_off(encoder);
+    }
+
+    uint32_t payload_size = encoder->payload_size();
+
+    std::vector<uint8_t> batch_payloads(batch_size * payload_size);
+    std::vector<uint8_t> payloads(batch_size * payload_size);
+    std::vector<uint8_t*> batch(batch_size);
+    std::vector<uint32_t> bytes_used(batch_size);
+
+    while(!decoder->is_complete())
+    {
+        for(uint32_t k = 0; k < batch_size; ++k)
+        {
+            batch[k] = &batch_payloads[k * payload_size];
+        }
+
+        batch_encoder->encode_batch(&batch[0], &bytes_used[0], batch_size);
+
+        for(uint32_t k = 0; k < batch_size; ++k)
+        {
+            uint8_t *payload = &payloads[k * payload_size];
+            uint32_t used = encoder->encode(payload);
+
+            EXPECT_EQ(used, bytes_used[k]);
+            EXPECT_TRUE(std::equal(payload, payload + used,
+                                   &batch_payloads[k * payload_size]));
+
+            decoder->decode(&batch_payloads[k * payload_size]);
+        }
+    }
+
+    EXPECT_EQ(encoder->encode_symbol_count(),
+              batch_encoder->encode_symbol_count());
+
+    std::vector<uint8_t> data_out(decoder->block_size(), '\0');
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(std::equal(data_out.begin(),
+                           data_out.end(),
+                           data_in.begin()));
+}
+
+template
+<
+    template <class> class Encoder,
+    template <class> class Decoder
+>
+inline void test_encode_batch(uint32_t symbols, uint32_t symbol_size,
+                              uint32_t batch_size)
+{
+    test_encode_batch<Encoder<fifi::binary>, Decoder<fifi::binary> >(
+        symbols, symbol_size, batch_size, false);
+
+    test_encode_batch<Encoder<fifi::binary8>, Decoder<fifi::binary8> >(
+        symbols, symbol_size, batch_size, false);
+
+    test_encode_batch<Encoder<fifi::binary16>, Decoder<fifi::binary16> >(
+        symbols, symbol_size, batch_size, false);
+
+    test_encode_batch<Encoder<fifi::binary8>, Decoder<fifi::binary8> >(
+        symbols, symbol_size, batch_size, true);
+}
+
+template
+<
+    template <class> class Encoder,
+    template <class> class Decoder
+>
+inline void test_encode_batch()
+{
+    test_encode_batch<Encoder, Decoder>(32, 1600, 1);
+    test_encode_batch<Encoder, Decoder>(32, 1600, 8);
+    test_encode_batch<Encoder, Decoder>(1, 1600, 4);
+
+    // Symbols larger than a tile
+    test_encode_batch<Encoder, Decoder>(16, 65536, 24);
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+    uint32_t batch_size = 1 + (rand() % symbols);
+
+    test_encode_batch<Encoder, Decoder>(symbols, symbol_size, batch_size);
+}
+
+/// Tests batch encoding with the full vector RLNC encoder
+TEST(TestBatchLinearBlockEncoder, test_full_rlnc)
+{
+    test_encode_batch<kodo::full_rlnc_encoder, kodo::full_rlnc_decoder>();
+}
+
+/// Tests batch encoding with the seed RLNC encoder, where the
+/// coefficients of every symbol are generated into the same buffer
+TEST(TestBatchLinearBlockEncoder, test_seed_rlnc)
+{
+    test_encode_batch<kodo::seed_rlnc_encoder, kodo::seed_rlnc_decoder>();
+}
+
+/// Tests batch encoding with the on-the-fly encoder which also writes
+/// the encoder rank to every payload
+TEST(TestBatchLinearBlockEncoder, test_on_the_fly)
+{
+    test_encode_batch<kodo::on_the_fly_encoder, kodo::on_the_fly_decoder>();
+}
+
+/// Tests that an empty batch does not produce any symbols
+TEST(TestBatchLinearBlockEncoder, test_empty_batch)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_type;
+
+    encoder_type::factory encoder_factory(10, 100);
+    auto encoder = encoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    uint8_t *payload = 0;
+    uint32_t bytes_used = 0;
+    encoder->encode_batch(&payload, &bytes_used, 0);
+
+    EXPECT_EQ(0U, encoder->encode_symbol_count());
+}
@@ -0,0 +1,46 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_bounded_resource_pool.cpp Unit tests for the bounded
+///       resource pool and the factories using it
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/bounded_resource_pool.hpp>
+#include <kodo/rlnc/seed_codes.hpp>
+
+#include "resource_pool_test_helper.hpp"
+
+TEST(TestBoundedResourcePool, test_reserve_and_max_pooled)
+{
+    kodo::bounded_resource_pool<dummy_resource> pool(&make_dummy);
+    test_reserve_and_max_pooled(pool);
+}
+
+/// Tests that the coders reserved by a factory are used by build()
+TEST(TestBoundedResourcePool, test_factory_reserve)
+{
+    typedef kodo::seed_rlnc_encoder<fifi::binary8> encoder_type;
+
+    encoder_type::factory factory(16, 64);
+    factory.reserve(3);
+    factory.set_max_pooled(2);
+
+    EXPECT_EQ(2U, factory.pool().unused_resources());
+    EXPECT_EQ(2U, factory.max_pooled());
+
+    {
+        auto a = factory.build();
+        auto b = factory.build();
+        auto c = factory.build();
+
+        EXPECT_EQ(2U, factory.pool().recycled_resources());
+        EXPECT_EQ(3U, factory.pool().used_high_water_mark());
+    }
+
+    EXPECT_EQ(2U, factory.pool().total_resources());
+}
@@ -10,11 +10,14 @@
 
 #include <gtest/gtest.h>
 
+#include <sak/is_aligned.hpp>
+
 
 #include <kodo/final_coder_factory.hpp>
 #include <kodo/final_coder_factory_pool.hpp>
 #include <kodo/finite_field_info.hpp>
 #include <kodo/coefficient_storage.hpp>
+#include <kodo/contiguous_coefficient_storage.hpp>
 #include <kodo/coefficient_info.hpp>
 #include <kodo/storage_block_info.hpp>
 
@@ -54,6 +57,30 @@ namespace kodo
                      > > > > >
     {};
 
+    // Contiguous Coefficient Storage
+    template<class Field>
+    class contiguous_coefficient_storage_stack
+        : public contiguous_coefficient_storage<
+                 coefficient_info<
+                 storage_block_info<
+                 finite_field_info<Field,
+                 final_coder_factory<
+                 contiguous_coefficient_storage_stack<Field>
+                     > > > > >
+    {};
+
+    // Contiguous Coefficient Storage
+    template<class Field>
+    class contiguous_coefficient_storage_stack_pool
+        : public contiguous_coefficient_storage<
+                 coefficient_info<
+                 storage_block_info<
+                 finite_field_info<Field,
+                 final_coder_factory_pool<
+                 contiguous_coefficient_storage_stack_pool<Field>
+                     > > > > >
+    {};
+
 }
 
 /// Tests:
@@ -202,3 +229,81 @@ TEST(TestSymbolStorage, test_coefficients_storage_stack)
 
 }
 
+/// Tests:
+///   - layer::coefficients_stride() const
+///
+/// Checks that the coefficient vectors of the contiguous storage are
+/// aligned and placed back to back using the padded stride.
+template<class Coder>
+struct api_contiguous_coefficients_storage
+{
+
+    typedef typename Coder::factory factory_type;
+    typedef typename Coder::pointer pointer_type;
+
+    api_contiguous_coefficients_storage(uint32_t max_symbols,
+                                        uint32_t max_symbol_size)
+        : m_factory(max_symbols, max_symbol_size)
+        { }
+
+    void run()
+        {
+            run_once(m_factory.max_symbols());
+
+            // Build with different from max values, if the factory
+            // recycles the coder the stride must be updated
+            run_once(rand_symbols(m_factory.max_symbols()));
+            run_once(m_factory.max_symbols());
+        }
+
+    void run_once(uint32_t symbols)
+        {
+            m_factory.set_symbols(symbols);
+
+            pointer_type coder = m_factory.build();
+
+            uint32_t stride = coder->coefficients_stride();
+
+            EXPECT_TRUE(stride >= coder->coefficients_size());
+            EXPECT_EQ(0U, stride % Coder::alignment);
+            EXPECT_TRUE(stride - coder->coefficients_size() <
+                        Coder::alignment);
+
+            for(uint32_t i = 0; i < symbols; ++i)
+            {
+                EXPECT_TRUE(sak::is_aligned(coder->coefficients(i)));
+
+                if(i > 0)
+                {
+                    EXPECT_EQ(coder->coefficients(i - 1) + stride,
+                              coder->coefficients(i));
+                }
+            }
+        }
+
+private:
+
+    // The factory
+    factory_type m_factory;
+
+};
+
+/// Run the tests on the contiguous coefficients stack
+TEST(TestSymbolStorage, test_contiguous_coefficients_storage_stack)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    // API tests:
+    run_test<
+        kodo::contiguous_coefficient_storage_stack,
+        api_coefficients_storage>(symbols, symbol_size);
+
+    run_test<
+        kodo::contiguous_coefficient_storage_stack,
+        api_contiguous_coefficients_storage>(symbols, symbol_size);
+
+    run_test<
+        kodo::contiguous_coefficient_storage_stack_pool,
+        api_contiguous_coefficients_storage>(symbols, symbol_size);
+}
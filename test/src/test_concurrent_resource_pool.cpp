@@ -0,0 +1,253 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_concurrent_resource_pool.cpp Unit tests for the
+///       concurrent resource pool and the factories using it
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/concurrent_resource_pool.hpp>
+#include <kodo/final_coder_factory_concurrent_pool.hpp>
+#include <kodo/rlnc/seed_codes.hpp>
+#include <kodo/systematic_operations.hpp>
+
+#include "basic_api_test_helper.hpp"
+#include "resource_pool_test_helper.hpp"
+
+namespace kodo
+{
+
+    // Seed decoder which can be built from several threads
+    template<class Field>
+    class concurrent_seed_rlnc_decoder
+        : public payload_decoder<
+                 systematic_decoder<
+                 symbol_id_decoder<
+                 seed_symbol_id_reader<
+                 uniform_generator<
+                 batch_linear_block_decoder<
+                 aligned_coefficients_decoder<
+                 innovation_check_decoder<
+                 forward_linear_block_decoder<
+                 contiguous_coefficient_storage<
+                 coefficient_info<
+                 deep_symbol_storage<
+                 storage_bytes_used<
+                 storage_block_info<
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 final_coder_factory_concurrent_pool<
+                 concurrent_seed_rlnc_decoder<Field>
+                     > > > > > > > > > > > > > > > > >
+    { };
+
+}
+
+/// Tests that resources are recycled and counted
+TEST(TestConcurrentResourcePool, test_recycle)
+{
+    {
+        kodo::concurrent_resource_pool<dummy_resource> pool(&make_dummy, 2);
+
+        EXPECT_EQ(2U, pool.caches());
+        EXPECT_EQ(0U, pool.total_resources());
+
+        {
+            auto a = pool.allocate();
+            auto b = pool.allocate();
+
+            EXPECT_NE(a.get(), b.get());
+            EXPECT_EQ(2U, pool.total_resources());
+            EXPECT_EQ(2U, pool.used_resources());
+            EXPECT_EQ(0U, pool.unused_resources());
+        }
+
+        EXPECT_EQ(2U, pool.total_resources());
+        EXPECT_EQ(0U, pool.used_resources());
+        EXPECT_EQ(2U, pool.unused_resources());
+        EXPECT_EQ(2, dummy_resource::count().load());
+
+        {
+            auto a = pool.allocate();
+            EXPECT_EQ(2U, pool.total_resources());
+            EXPECT_EQ(1U, pool.unused_resources());
+        }
+
+        EXPECT_EQ(2U, pool.used_high_water_mark());
+        EXPECT_EQ(2U, pool.total_high_water_mark());
+
+        pool.free_unused_resources();
+
+        EXPECT_EQ(0U, pool.total_resources());
+        EXPECT_EQ(0U, pool.unused_resources());
+        EXPECT_EQ(0, dummy_resource::count().load());
+
+        // The nodes of the freed resources are reused
+        auto c = pool.allocate();
+        EXPECT_EQ(1U, pool.total_resources());
+        EXPECT_EQ(2U, pool.total_high_water_mark());
+    }
+
+    EXPECT_EQ(0, dummy_resource::count().load());
+}
+
+/// Tests that resources in use outlive the pool
+TEST(TestConcurrentResourcePool, test_outlive_pool)
+{
+    boost::shared_ptr<dummy_resource> resource;
+
+    {
+        kodo::concurrent_resource_pool<dummy_resource> pool(&make_dummy);
+        resource = pool.allocate();
+    }
+
+    EXPECT_EQ(1, dummy_resource::count().load());
+
+    resource.reset();
+    EXPECT_EQ(0, dummy_resource::count().load());
+}
+
+/// Tests allocating and releasing resources from several threads
+TEST(TestConcurrentResourcePool, test_threads)
+{
+    uint32_t threads = 8;
+    uint32_t rounds = 2000;
+    uint32_t per_round = 3;
+
+    kodo::concurrent_resource_pool<dummy_resource> pool(&make_dummy, 4);
+
+    std::atomic<uint32_t> errors(0);
+    std::vector<std::thread> workers;
+
+    for(uint32_t t = 0; t < threads; ++t)
+    {
+        workers.push_back(std::thread([&]()
+            {
+                for(uint32_t r = 0; r < rounds; ++r)
+                {
+                    std::vector<boost::shared_ptr<dummy_resource> > held;
+
+                    for(uint32_t i = 0; i < per_round; ++i)
+                    {
+                        held.push_back(pool.allocate());
+                    }
+
+                    // No resource may be handed out twice
+                    for(uint32_t i = 0; i < per_round; ++i)
+                    {
+                        for(uint32_t j = i + 1; j < per_round; ++j)
+                        {
+                            if(held[i].get() == held[j].get())
+                            {
+                                ++errors;
+                            }
+                        }
+                    }
+                }
+            }));
+    }
+
+    for(auto &w : workers)
+    {
+        w.join();
+    }
+
+    EXPECT_EQ(0U, errors.load());
+    EXPECT_EQ(0U, pool.used_resources());
+    EXPECT_EQ(pool.total_resources(), pool.unused_resources());
+    EXPECT_LE(pool.total_resources(), threads * per_round);
+    EXPECT_LE(pool.used_high_water_mark(), threads * per_round);
+    EXPECT_EQ(int32_t(pool.total_resources()),
+              dummy_resource::count().load());
+}
+
+/// Tests building decoders from one factory on several threads
+TEST(TestConcurrentResourcePool, test_factory_threads)
+{
+    typedef kodo::seed_rlnc_encoder<fifi::binary8> encoder_type;
+    typedef kodo::concurrent_seed_rlnc_decoder<fifi::binary8> decoder_type;
+
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 64;
+    uint32_t threads = 4;
+    uint32_t rounds = 50;
+
+    encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    kodo::set_systematic_off(encoder);
+
+    std::vector<std::vector<uint8_t> > payloads(2 * symbols);
+
+    for(auto &payload : payloads)
+    {
+        payload.resize(encoder->payload_size());
+        encoder->encode(&payload[0]);
+    }
+
+    decoder_type::factory decoder_factory(symbols, symbol_size);
+
+    std::atomic<uint32_t> errors(0);
+    std::vector<std::thread> workers;
+
+    for(uint32_t t = 0; t < threads; ++t)
+    {
+        workers.push_back(std::thread([&]()
+            {
+                for(uint32_t r = 0; r < rounds; ++r)
+                {
+                    auto decoder = decoder_factory.build();
+
+                    for(uint32_t i = 0; i < payloads.size(); ++i)
+                    {
+                        if(decoder->is_complete())
+                        {
+                            break;
+                        }
+
+                        // The decoder works on the payload
+                        std::vector<uint8_t> payload = payloads[i];
+                        decoder->decode(&payload[0]);
+                    }
+
+                    std::vector<uint8_t> data_out(decoder->block_size());
+                    decoder->copy_symbols(sak::storage(data_out));
+
+                    if(!decoder->is_complete() || data_out != data_in)
+                    {
+                        ++errors;
+                    }
+                }
+            }));
+    }
+
+    for(auto &w : workers)
+    {
+        w.join();
+    }
+
+    EXPECT_EQ(0U, errors.load());
+
+    auto &pool = decoder_factory.pool();
+
+    EXPECT_EQ(0U, pool.used_resources());
+    EXPECT_LE(pool.total_resources(), threads);
+    EXPECT_LE(pool.used_high_water_mark(), threads);
+    EXPECT_GE(pool.used_high_water_mark(), 1U);
+}
+
+TEST(TestConcurrentResourcePool, test_reserve_and_max_pooled)
+{
+    kodo::concurrent_resource_pool<dummy_resource> pool(&make_dummy, 2);
+    test_reserve_and_max_pooled(pool);
+}
@@ -0,0 +1,79 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_field_registry.cpp Unit tests for the field registry
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/default_field.hpp>
+
+#include <kodo/field_registry.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+/// Tests that the same field instance is returned to all users and
+/// that the instances of different fields are distinct
+TEST(TestFieldRegistry, test_shared_instance)
+{
+    typedef fifi::default_field<fifi::binary8>::type binary8_impl;
+    typedef fifi::default_field<fifi::binary16>::type binary16_impl;
+
+    auto first = kodo::field_registry<binary8_impl>::get();
+    auto second = kodo::field_registry<binary8_impl>::get();
+
+    EXPECT_TRUE(bool(first));
+    EXPECT_EQ(first, second);
+
+    auto other = kodo::field_registry<binary16_impl>::get();
+    EXPECT_NE((void*) first.get(), (void*) other.get());
+}
+
+/// Tests that the factories share the field instance of the registry
+TEST(TestFieldRegistry, test_factories)
+{
+    typedef fifi::default_field<fifi::binary8>::type field_impl;
+
+    auto field = kodo::field_registry<field_impl>::get();
+    long uses = field.use_count();
+
+    {
+        kodo::full_rlnc_encoder<fifi::binary8>::factory encoder(10, 100);
+        kodo::full_rlnc_decoder<fifi::binary8>::factory decoder(10, 100);
+
+        EXPECT_LT(uses, field.use_count());
+    }
+
+    EXPECT_EQ(uses, field.use_count());
+}
+
+/// Tests that the instance built concurrently is the same on all
+/// threads
+TEST(TestFieldRegistry, test_threads)
+{
+    typedef fifi::default_field<fifi::prime2325>::type field_impl;
+
+    std::vector<const field_impl*> fields(8, 0);
+    std::vector<std::thread> workers;
+
+    for(uint32_t i = 0; i < fields.size(); ++i)
+    {
+        workers.push_back(std::thread([&fields, i]()
+            {
+                fields[i] = kodo::field_registry<field_impl>::get().get();
+            }));
+    }
+
+    for(auto &w : workers)
+    {
+        w.join();
+    }
+
+    for(uint32_t i = 1; i < fields.size(); ++i)
+    {
+        EXPECT_EQ(fields[0], fields[i]);
+    }
+}
@@ -0,0 +1,135 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_file_decoder.cpp Unit tests for the file decoder, which
+///       is only available with the POSIX file API
+
+#include <kodo/posix_file_api.hpp>
+
+#if defined(KODO_POSIX_FILE_API)
+
+#include <stdint.h>
+
+#include <fstream>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+#include <kodo/file_decoder.hpp>
+#include <kodo/object_encoder.hpp>
+#include <kodo/storage_reader.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/systematic_operations.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Tests that the file decoder writes the blocks to the file as they
+/// complete and only keeps the blocks in flight in memory
+TEST(TestFileDecoder, test_file_decoder)
+{
+    std::string decode_filename = "decode-file-decoder";
+
+    // The last block is partial
+    uint32_t size = 5003;
+    std::vector<uint8_t> data_in = random_vector(size);
+
+    typedef kodo::full_rlnc_encoder<fifi::binary8>
+        encoder_t;
+
+    typedef kodo::full_rlnc_decoder<fifi::binary8>
+        decoder_t;
+
+    typedef kodo::object_encoder<kodo::storage_reader<encoder_t>, encoder_t>
+        object_encoder_t;
+
+    typedef kodo::file_decoder<decoder_t>
+        file_decoder_t;
+
+    uint32_t max_symbols = 8;
+    uint32_t max_symbol_size = 64;
+
+    encoder_t::factory encoder_factory(max_symbols, max_symbol_size);
+
+    object_encoder_t object_encoder(
+        encoder_factory, kodo::storage_reader<encoder_t>(
+            sak::storage(data_in)));
+
+    std::vector<encoder_t::pointer> encoders;
+
+    for(uint32_t i = 0; i < object_encoder.encoders(); ++i)
+    {
+        encoders.push_back(object_encoder.build(i));
+        kodo::set_systematic_off(encoders.back());
+    }
+
+    {
+        decoder_t::factory decoder_factory(max_symbols, max_symbol_size);
+
+        file_decoder_t file_decoder(decoder_factory, decode_filename, size);
+        EXPECT_EQ(object_encoder.encoders(), file_decoder.decoders());
+
+        std::vector<uint8_t> payload(encoders[0]->payload_size());
+
+        // Two blocks are decoded at a time with their packets
+        // interleaved
+        for(uint32_t i = 0; i < encoders.size(); i += 2)
+        {
+            uint32_t last = std::min<uint32_t>(i + 2, encoders.size());
+
+            while(!file_decoder.is_block_written(last - 1) ||
+                  !file_decoder.is_block_written(i))
+            {
+                for(uint32_t j = i; j < last; ++j)
+                {
+                    encoders[j]->encode(&payload[0]);
+                    file_decoder.decode(j, &payload[0]);
+                }
+
+                EXPECT_LE(file_decoder.blocks_in_flight(), 2U);
+            }
+        }
+
+        EXPECT_TRUE(file_decoder.is_complete());
+        EXPECT_EQ(0U, file_decoder.blocks_in_flight());
+
+        // The decoders are recycled between the blocks
+        EXPECT_LE(decoder_factory.pool().total_resources(), 2U);
+    }
+
+    std::ifstream decode_file(decode_filename, std::ios::binary);
+    std::vector<uint8_t> data_out(size + 1, 0);
+
+    decode_file.read(reinterpret_cast<char*>(&data_out[0]), size + 1);
+    EXPECT_EQ(size, uint32_t(decode_file.gcount()));
+
+    data_out.resize(size);
+    EXPECT_EQ(data_in, data_out);
+
+    decode_file.close();
+    boost::filesystem::remove(decode_filename);
+}
+
+/// Tests that a file which cannot be created is reported with an
+/// exception
+TEST(TestFileDecoder, test_file_decoder_errors)
+{
+    typedef kodo::full_rlnc_decoder<fifi::binary8>
+        decoder_t;
+
+    typedef kodo::file_decoder<decoder_t>
+        file_decoder_t;
+
+    decoder_t::factory decoder_factory(8, 64);
+
+    std::string decode_filename = "missing-directory/decode-file-decoder";
+
+    EXPECT_THROW(
+        file_decoder_t file_decoder(decoder_factory, decode_filename, 100),
+        std::system_error);
+}
+
+#endif
@@ -0,0 +1,93 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_find_nonzero.cpp Unit tests for the word-at-a-time
+///       coefficient scanning functions
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/field_types.hpp>
+
+#include <kodo/bit_scan.hpp>
+#include <kodo/find_nonzero.hpp>
+
+/// Compares the scanning functions with a plain element by element
+/// scan of randomly filled coefficient vectors
+template<class Field>
+inline void test_find_nonzero(uint32_t elements, uint32_t density)
+{
+    typedef typename Field::value_type value_type;
+
+    uint32_t length = fifi::elements_to_length<Field>(elements);
+
+    std::vector<value_type> vector(length, 0);
+
+    for(uint32_t i = 0; i < elements; ++i)
+    {
+        if((rand() % density) == 0)
+        {
+            fifi::set_value<Field>(&vector[0], i, 1U);
+        }
+    }
+
+    for(uint32_t begin = 0; begin <= elements; ++begin)
+    {
+        uint32_t end = begin + (rand() % (elements - begin + 1));
+
+        uint32_t first = end;
+        uint32_t last = end;
+
+        for(uint32_t i = begin; i < end; ++i)
+        {
+            if(fifi::get_value<Field>(&vector[0], i))
+            {
+                if(first == end)
+                {
+                    first = i;
+                }
+
+                last = i;
+            }
+        }
+
+        EXPECT_EQ(first, kodo::find_nonzero<Field>(&vector[0], begin, end));
+        EXPECT_EQ(last, kodo::rfind_nonzero<Field>(&vector[0], begin, end));
+    }
+}
+
+template<class Field>
+inline void test_find_nonzero()
+{
+    test_find_nonzero<Field>(1, 1);
+    test_find_nonzero<Field>(300, 1);
+    test_find_nonzero<Field>(300, 50);
+    test_find_nonzero<Field>(300, 1000);
+    test_find_nonzero<Field>(1 + (rand() % 500), 1 + (rand() % 100));
+}
+
+/// Tests the bit scan helpers
+TEST(TestFindNonzero, test_bit_scan)
+{
+    EXPECT_EQ(0U, kodo::count_trailing_zeros(1U));
+    EXPECT_EQ(3U, kodo::count_trailing_zeros(0xF8U));
+    EXPECT_EQ(63U, kodo::count_trailing_zeros(1ULL << 63));
+
+    EXPECT_EQ(0U, kodo::most_significant_bit(1U));
+    EXPECT_EQ(7U, kodo::most_significant_bit(0xF8U));
+    EXPECT_EQ(63U, kodo::most_significant_bit(~0ULL));
+}
+
+/// Tests finding the first and last non-zero coefficients
+TEST(TestFindNonzero, test_find_nonzero)
+{
+    test_find_nonzero<fifi::binary>();
+    test_find_nonzero<fifi::binary8>();
+    test_find_nonzero<fifi::binary16>();
+    test_find_nonzero<fifi::prime2325>();
+}
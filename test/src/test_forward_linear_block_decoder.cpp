@@ -15,6 +15,7 @@
 #include <kodo/debug_linear_block_decoder.hpp>
 
 #include "basic_api_test_helper.hpp"
+#include "linear_block_decoder_test_helper.hpp"
 
 namespace kodo
 {
@@ -223,5 +224,9 @@ TEST(TestLinearBlockDecoder, test_decoder_delayed)
     test_forward_stack<kodo::test_forward_delayed_stack>();
 }
 
-
-
+/// Checks that the binary delayed decoder recovers the original symbols
+/// when the final backward substitution spans several pivot groups
+TEST(TestLinearBlockDecoder, test_decoder_delayed_binary)
+{
+    test_decode_binary_combinations<kodo::test_forward_delayed_stack>();
+}
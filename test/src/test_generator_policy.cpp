@@ -0,0 +1,124 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_generator_policy.cpp Unit tests for the random generator
+///       policies used by the coefficient generators
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <kodo/mt19937_generator_policy.hpp>
+#include <kodo/splitmix64_generator_policy.hpp>
+#include <kodo/xoshiro256_generator_policy.hpp>
+
+/// Checks that reseeding repeats the bytes and that a fill with a
+/// size which is not a multiple of 8 produces a prefix of a larger fill
+template<class Policy>
+inline void test_generator_policy_fill(uint32_t size)
+{
+    Policy policy;
+
+    std::vector<uint8_t> a(size + 8);
+    std::vector<uint8_t> b(size + 8);
+    std::vector<uint8_t> c(size);
+
+    policy.seed(7);
+    policy.fill(&a[0], size + 8);
+
+    policy.seed(7);
+    policy.fill(&b[0], size + 8);
+
+    EXPECT_EQ(a, b);
+
+    policy.seed(7);
+    policy.fill(&c[0], size);
+
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), a.begin()));
+
+    // A different seed should give different bytes
+    policy.seed(8);
+    policy.fill(&b[0], size + 8);
+
+    EXPECT_NE(a, b);
+}
+
+TEST(TestGeneratorPolicy, test_fill)
+{
+    test_generator_policy_fill<kodo::mt19937_generator_policy>(1);
+    test_generator_policy_fill<kodo::mt19937_generator_policy>(77);
+
+    test_generator_policy_fill<kodo::splitmix64_generator_policy>(1);
+    test_generator_policy_fill<kodo::splitmix64_generator_policy>(8);
+    test_generator_policy_fill<kodo::splitmix64_generator_policy>(77);
+
+    test_generator_policy_fill<kodo::xoshiro256_generator_policy>(1);
+    test_generator_policy_fill<kodo::xoshiro256_generator_policy>(8);
+    test_generator_policy_fill<kodo::xoshiro256_generator_policy>(77);
+}
+
+/// The mt19937 policy must keep generating the coefficients of earlier
+/// releases since they are part of the seed codes wire format
+TEST(TestGeneratorPolicy, test_mt19937_compatibility)
+{
+    boost::random::mt19937 generator;
+    boost::random::uniform_int_distribution<uint8_t> distribution;
+
+    kodo::mt19937_generator_policy policy;
+
+    generator.seed(42);
+    policy.seed(42);
+
+    std::vector<uint8_t> data(100);
+    policy.fill(&data[0], data.size());
+
+    for(uint32_t i = 0; i < data.size(); ++i)
+    {
+        EXPECT_EQ(distribution(generator), data[i]);
+    }
+}
+
+/// Checks the xoshiro256 policy against reference values of the
+/// splitmix64 seeding followed by the xoshiro256** generator
+TEST(TestGeneratorPolicy, test_xoshiro256_reference)
+{
+    kodo::xoshiro256_generator_policy policy;
+
+    policy.seed(0);
+    EXPECT_EQ(0x99ec5f36cb75f2b4ULL, policy());
+    EXPECT_EQ(0xbf6e1f784956452aULL, policy());
+
+    policy.seed(42);
+    EXPECT_EQ(0x15780b2e0c2ec716ULL, policy());
+
+    // The bytes are written in little endian order
+    std::vector<uint8_t> data(3);
+
+    policy.seed(42);
+    policy.fill(&data[0], data.size());
+
+    EXPECT_EQ(0x16, data[0]);
+    EXPECT_EQ(0xc7, data[1]);
+    EXPECT_EQ(0x2e, data[2]);
+}
+
+/// Checks the splitmix64 policy against reference values of the
+/// splitmix64 generator
+TEST(TestGeneratorPolicy, test_splitmix64_reference)
+{
+    kodo::splitmix64_generator_policy policy;
+
+    policy.seed(0);
+    EXPECT_EQ(0xe220a8397b1dcdafULL, policy());
+    EXPECT_EQ(0x6e789e6aa1b965f4ULL, policy());
+
+    // Reseeding restarts the sequence
+    policy.seed(0);
+    EXPECT_EQ(0xe220a8397b1dcdafULL, policy());
+}
@@ -0,0 +1,119 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_geometric_sparse_generator.cpp Unit tests for the
+///       geometric sparse coefficient generator
+
+#include <kodo/geometric_sparse_generator.hpp>
+#include <kodo/rlnc/sparse_full_vector_codes.hpp>
+
+#include "coefficient_generator_helper.hpp"
+#include "helper_test_basic_api.hpp"
+
+namespace kodo
+{
+
+    // Geometric sparse generator
+    template<class Field>
+    class geometric_sparse_generator_stack_pool :
+        public geometric_sparse_generator<
+               fake_codec_layer<
+               coefficient_info<
+               fake_symbol_storage<
+               storage_block_info<
+               finite_field_info<Field,
+               final_coder_factory_pool<
+               geometric_sparse_generator_stack_pool<Field>
+               > > > > > > >
+    { };
+
+}
+
+/// Checks that the recorded positions match the non-zero coefficients
+/// and that the number of non-zero coefficients follows the density
+template<class Field>
+inline void test_geometric_positions(uint32_t symbols, double density)
+{
+    typedef typename Field::value_type value_type;
+
+    typename kodo::geometric_sparse_generator_stack_pool<Field>::factory
+        factory(symbols, 100);
+
+    auto coder = factory.build();
+    coder->set_density(density);
+    EXPECT_EQ(density, coder->get_density());
+
+    std::vector<uint8_t> coefficients(coder->coefficients_size());
+    const value_type *c =
+        reinterpret_cast<const value_type*>(&coefficients[0]);
+
+    uint32_t vectors = 50;
+    uint32_t total = 0;
+
+    for(uint32_t k = 0; k < vectors; ++k)
+    {
+        coder->generate(&coefficients[0]);
+
+        const uint32_t *positions = coder->nonzero_positions();
+        uint32_t count = coder->nonzero_count();
+
+        uint32_t p = 0;
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            if(fifi::get_value<Field>(c, i) == 0)
+            {
+                continue;
+            }
+
+            ASSERT_LT(p, count);
+            EXPECT_EQ(i, positions[p]);
+            ++p;
+        }
+
+        EXPECT_EQ(count, p);
+        total += count;
+    }
+
+    double expected = density * symbols * vectors;
+
+    if(density >= 1)
+    {
+        EXPECT_EQ(symbols * vectors, total);
+    }
+    else
+    {
+        // Allow five standard deviations
+        double deviation = 5 * std::sqrt(expected * (1 - density)) + 1;
+        EXPECT_NEAR(expected, double(total), deviation);
+    }
+}
+
+TEST(TestGeometricSparseGenerator, test_api)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    run_test<
+        kodo::geometric_sparse_generator_stack_pool,
+        api_generate>(symbols, symbol_size);
+}
+
+TEST(TestGeometricSparseGenerator, test_positions)
+{
+    test_geometric_positions<fifi::binary>(4096, 0.01);
+    test_geometric_positions<fifi::binary>(4096, 0.03);
+    test_geometric_positions<fifi::binary8>(4096, 0.02);
+    test_geometric_positions<fifi::binary16>(100, 0.5);
+    test_geometric_positions<fifi::binary8>(64, 1.0);
+}
+
+/// Tests that the symbols encoded using the positions of the generator
+/// decode correctly
+TEST(TestGeometricSparseGenerator, test_encode_sparse_symbol)
+{
+    test_basic_api<kodo::sparse_full_rlnc_encoder,
+                   kodo::sparse_full_rlnc_decoder>();
+}
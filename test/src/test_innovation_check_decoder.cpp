@@ -0,0 +1,92 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_innovation_check_decoder.cpp Unit tests for the
+///       kodo::innovation_check_decoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Checks that non-innovative symbols are dropped without changing the
+/// symbol data and that innovative symbols are still decoded
+template<class Field>
+inline void test_innovation_check(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef kodo::full_rlnc_decoder<Field> decoder_type;
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    // Give the decoder the first half of the symbols uncoded
+    uint32_t known = symbols / 2;
+
+    for(uint32_t i = 0; i < known; ++i)
+    {
+        std::vector<uint8_t> symbol = random_vector(decoder->symbol_size());
+        decoder->decode_symbol(&symbol[0], i);
+    }
+
+    EXPECT_EQ(known, decoder->rank());
+
+    // A symbol which only combines the known symbols is not innovative
+    std::vector<uint8_t> coefficients(decoder->coefficients_size(), 0);
+
+    for(uint32_t i = 0; i < known; ++i)
+    {
+        fifi::set_value<Field>(
+            reinterpret_cast<typename Field::value_type*>(&coefficients[0]),
+            i, 1U);
+    }
+
+    std::vector<uint8_t> symbol = random_vector(decoder->symbol_size());
+    std::vector<uint8_t> original = symbol;
+
+    decoder->decode_symbol(&symbol[0], &coefficients[0]);
+
+    EXPECT_EQ(known, decoder->rank());
+    EXPECT_TRUE(symbol == original);
+
+    // Adding an unknown symbol makes it innovative
+    std::fill(coefficients.begin(), coefficients.end(), 0);
+
+    for(uint32_t i = 0; i < known + 1; ++i)
+    {
+        fifi::set_value<Field>(
+            reinterpret_cast<typename Field::value_type*>(&coefficients[0]),
+            i, 1U);
+    }
+
+    decoder->decode_symbol(&symbol[0], &coefficients[0]);
+
+    EXPECT_EQ(known + 1, decoder->rank());
+    EXPECT_TRUE(decoder->symbol_pivot(known));
+}
+
+template<class Field>
+inline void test_innovation_check()
+{
+    test_innovation_check<Field>(32, 1600);
+    test_innovation_check<Field>(2, 1600);
+
+    uint32_t symbols = std::max(2U, rand_symbols());
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_innovation_check<Field>(symbols, symbol_size);
+}
+
+/// Tests that non-innovative symbols are dropped before the symbol
+/// data is touched
+TEST(TestInnovationCheckDecoder, test_innovation_check)
+{
+    test_innovation_check<fifi::binary>();
+    test_innovation_check<fifi::binary8>();
+    test_innovation_check<fifi::binary16>();
+}
@@ -0,0 +1,134 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_linear_block_encoder.cpp Unit tests for the
+///       kodo::linear_block_encoder layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/fifi_utils.hpp>
+
+#include <kodo/rlnc/full_vector_codes.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Encodes symbols into buffers holding junk data and checks that the
+/// result matches the symbols accumulated into zeroed buffers, i.e. that
+/// the encoder does not depend on the buffer being zeroed in advance
+template<class Field>
+inline void test_overwrite_encoding(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef typename Field::value_type value_type;
+
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    uint32_t coefficients_size = encoder->coefficients_size();
+    uint32_t symbol_length = encoder->symbol_length();
+
+    // The last coefficient vector is all zeros
+    uint32_t count = 4;
+
+    std::vector< std::vector<uint8_t> > coefficients(count);
+    std::vector< std::vector<uint8_t> > expected(count);
+    std::vector< std::vector<uint8_t> > single(count);
+    std::vector< std::vector<uint8_t> > batch(count);
+
+    std::vector<uint8_t*> coefficients_data(count);
+    std::vector<uint8_t*> batch_data(count);
+
+    for(uint32_t k = 0; k < count; ++k)
+    {
+        coefficients[k].resize(coefficients_size, 0);
+
+        if(k + 1 < count)
+        {
+            encoder->generate(&coefficients[k][0]);
+        }
+
+        // Accumulate the reference into a zeroed buffer
+        expected[k].resize(symbol_size, 0);
+
+        value_type *symbol =
+            reinterpret_cast<value_type*>(&expected[k][0]);
+
+        const value_type *c =
+            reinterpret_cast<const value_type*>(&coefficients[k][0]);
+
+        for(uint32_t i = 0; i < symbols; ++i)
+        {
+            value_type value = fifi::get_value<Field>(c, i);
+
+            if(value != 0)
+            {
+                encoder->multiply_add(symbol, encoder->symbol_value(i),
+                                      value, symbol_length);
+            }
+        }
+
+        single[k] = random_vector(symbol_size);
+        batch[k] = random_vector(symbol_size);
+
+        coefficients_data[k] = &coefficients[k][0];
+        batch_data[k] = &batch[k][0];
+    }
+
+    for(uint32_t k = 0; k < count; ++k)
+    {
+        encoder->encode_symbol(&single[k][0], coefficients_data[k]);
+        EXPECT_EQ(expected[k], single[k]);
+    }
+
+    encoder->encode_symbols(&batch_data[0], &coefficients_data[0], count);
+
+    for(uint32_t k = 0; k < count; ++k)
+    {
+        EXPECT_EQ(expected[k], batch[k]);
+    }
+}
+
+TEST(TestLinearBlockEncoder, test_overwrite_encoding)
+{
+    test_overwrite_encoding<fifi::binary>(1, 1600);
+    test_overwrite_encoding<fifi::binary>(32, 1400);
+    test_overwrite_encoding<fifi::binary8>(1, 1600);
+    test_overwrite_encoding<fifi::binary8>(32, 1400);
+    test_overwrite_encoding<fifi::binary16>(32, 1400);
+}
+
+/// Checks that the pivots of the encoder are updated when the symbols
+/// are swapped into the encoder, as done by the file_reader
+TEST(TestLinearBlockEncoder, test_swap_symbols_pivots)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_type;
+
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 160;
+
+    encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    EXPECT_EQ(0U, encoder->rank());
+    EXPECT_FALSE(encoder->symbol_pivots().test(0));
+
+    std::vector<uint8_t> data = random_vector(encoder->block_size());
+    encoder->swap_symbols(data);
+
+    EXPECT_EQ(symbols, encoder->rank());
+
+    for(uint32_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_TRUE(encoder->symbol_pivot(i));
+        EXPECT_TRUE(encoder->symbol_pivots().test(i));
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_mapped_file_encoder.cpp Unit tests for the mapped file
+///       encoder, which is only available with the POSIX file API
+
+#include <kodo/posix_file_api.hpp>
+
+#if defined(KODO_POSIX_FILE_API)
+
+#include <stdint.h>
+
+#include <fstream>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+#include <kodo/mapped_file_encoder.hpp>
+#include <kodo/object_decoder.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
+#include <kodo/systematic_operations.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Tests that encoding and decoding a file with the mapped file encoder
+/// works, also when the last symbol of the file is partial
+TEST(TestFileEncoder, test_mapped_file_encoder)
+{
+    std::string encode_filename = "encode-mapped-file";
+
+    // The last block and its last symbol are partial
+    uint32_t size = 1003;
+    std::vector<uint8_t> data_in = random_vector(size);
+
+    {
+        std::ofstream encode_file;
+        encode_file.open(encode_filename, std::ios::binary);
+        encode_file.write(reinterpret_cast<char*>(&data_in[0]), size);
+    }
+
+    typedef kodo::shallow_full_rlnc_encoder<fifi::binary8>
+        encoder_t;
+
+    typedef kodo::full_rlnc_decoder<fifi::binary8>
+        decoder_t;
+
+    typedef kodo::mapped_file_encoder<encoder_t>
+        file_encoder_t;
+
+    typedef kodo::object_decoder<decoder_t>
+        object_decoder_t;
+
+    uint32_t max_symbols = 10;
+    uint32_t max_symbol_size = 16;
+
+    file_encoder_t::factory encoder_factory(
+        max_symbols, max_symbol_size);
+
+    file_encoder_t file_encoder(encoder_factory, encode_filename);
+    EXPECT_EQ(size, file_encoder.object_size());
+
+    object_decoder_t::factory decoder_factory(
+        max_symbols, max_symbol_size);
+
+    object_decoder_t object_decoder(decoder_factory, size);
+
+    EXPECT_EQ(object_decoder.decoders(), file_encoder.encoders());
+
+    std::vector<uint8_t> data_out;
+
+    for(uint32_t i = 0; i < file_encoder.encoders(); ++i)
+    {
+        auto encoder = file_encoder.build(i);
+        auto decoder = object_decoder.build(i);
+
+        EXPECT_EQ(encoder->bytes_used(), decoder->bytes_used());
+
+        kodo::set_systematic_off(encoder);
+
+        std::vector<uint8_t> payload(encoder->payload_size());
+
+        while(!decoder->is_complete())
+        {
+            encoder->encode(&payload[0]);
+            decoder->decode(&payload[0]);
+        }
+
+        std::vector<uint8_t> block(decoder->block_size());
+        decoder->copy_symbols(sak::storage(block));
+
+        // The padding of the block must be zero
+        for(uint32_t j = decoder->bytes_used(); j < block.size(); ++j)
+        {
+            EXPECT_EQ(0U, block[j]);
+        }
+
+        data_out.insert(data_out.end(), block.begin(),
+                        block.begin() + decoder->bytes_used());
+    }
+
+    EXPECT_EQ(data_in, data_out);
+
+    boost::filesystem::remove(encode_filename);
+}
+
+/// Tests that a file which cannot be mapped is reported with an exception
+TEST(TestFileEncoder, test_mapped_file_encoder_errors)
+{
+    typedef kodo::shallow_full_rlnc_encoder<fifi::binary8>
+        encoder_t;
+
+    typedef kodo::mapped_file_encoder<encoder_t>
+        file_encoder_t;
+
+    file_encoder_t::factory encoder_factory(10, 16);
+
+    std::string missing_filename = "missing-mapped-file";
+    boost::filesystem::remove(missing_filename);
+
+    EXPECT_THROW(file_encoder_t encoder(encoder_factory, missing_filename),
+                 std::system_error);
+
+    // An empty file cannot be mapped
+    std::string empty_filename = "empty-mapped-file";
+
+    {
+        std::ofstream empty_file;
+        empty_file.open(empty_filename, std::ios::binary);
+    }
+
+    EXPECT_THROW(file_encoder_t encoder(encoder_factory, empty_filename),
+                 std::system_error);
+
+    boost::filesystem::remove(empty_filename);
+}
+
+#endif
@@ -6,12 +6,19 @@
 /// @file test_object_xyz.cpp Unit tests for object encoder and decoders
 
 #include <ctime>
+#include <mutex>
 
 #include <gtest/gtest.h>
 
 #include <kodo/object_decoder.hpp>
 #include <kodo/object_encoder.hpp>
+#include <kodo/parallel_object_decoder.hpp>
+#include <kodo/parallel_object_encoder.hpp>
 #include <kodo/rfc5052_partitioning_scheme.hpp>
+#include <kodo/storage_reader.hpp>
+#include <kodo/thread_pool.hpp>
+#include <kodo/systematic_operations.hpp>
+#include <kodo/rlnc/full_vector_codes.hpp>
 
 #include "basic_api_test_helper.hpp"
 
@@ -127,21 +134,21 @@ public:
     /// Test function need to test whether the encoder
     /// is initialized with data from the right offset
     /// @param byte_offset The offset in bytes
-    void set_byte_offset(uint32_t byte_offset)
+    void set_byte_offset(uint64_t byte_offset)
         {
             m_byte_offset = byte_offset;
         }
 
     /// Test function returning the byte offset
     /// @return The byte offset of the encoder
-    uint32_t byte_offset() const
+    uint64_t byte_offset() const
         {
             return m_byte_offset;
         }
 
     uint32_t m_symbols;
     uint32_t m_symbol_size;
-    uint32_t m_byte_offset;
+    uint64_t m_byte_offset;
     uint32_t m_bytes_used;
 
 };
@@ -153,27 +160,27 @@ public:
 
     typedef dummy_coder::pointer pointer;
 
-    dummy_object_data(uint32_t size)
+    dummy_object_data(uint64_t size)
         : m_size(size)
         {}
 
 
-    /// @copydoc object_data::read(pointer, uint32_t, uint32_t)
-    void read(pointer &coder, uint32_t offset, uint32_t size)
+    /// @copydoc object_data::read(pointer, uint64_t, uint32_t)
+    void read(pointer &coder, uint64_t offset, uint32_t size)
         {
             coder->set_bytes_used(size);
             coder->set_byte_offset(offset);
         }
 
     /// @copydoc object_data::size() const
-    uint32_t size() const
+    uint64_t size() const
         {
             return m_size;
         }
 
 private:
 
-    uint32_t m_size;
+    uint64_t m_size;
 
 };
 
@@ -269,3 +276,168 @@ TEST(TestObjectCoder, construct_and_invoke_the_basic_api)
     test_object_coders(symbols, symbol_size, multiplier);
 }
 
+/// Tests that the parallel object encoder produces the payloads of all
+/// blocks and that the object can be decoded from them
+TEST(TestObjectCoder, test_parallel_object_encoder)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_t;
+    typedef kodo::full_rlnc_decoder<fifi::binary8> decoder_t;
+
+    typedef kodo::parallel_object_encoder<
+        kodo::storage_reader<encoder_t>, encoder_t> parallel_encoder_t;
+
+    typedef kodo::object_decoder<decoder_t> object_decoder_t;
+
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+
+    // The last block is partial
+    uint32_t object_size = 20 * max_symbols * max_symbol_size + 33;
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    parallel_encoder_t encoder(
+        max_symbols, max_symbol_size,
+        kodo::storage_reader<encoder_t>(sak::storage(data_in)),
+        boost::make_shared<kodo::thread_pool>(4));
+
+    EXPECT_EQ(4U, encoder.threads());
+    EXPECT_EQ(object_size, encoder.object_size());
+
+    // The payloads received for every block
+    std::vector<std::vector<std::vector<uint8_t> > > payloads(
+        encoder.encoders());
+
+    std::mutex payloads_mutex;
+
+    // A few extra payloads per block in case of linear dependencies
+    uint32_t payloads_per_block = max_symbols + 4;
+
+    encoder.encode(payloads_per_block,
+        [&](uint32_t block, const uint8_t* payload, uint32_t size)
+        {
+            std::lock_guard<std::mutex> lock(payloads_mutex);
+            payloads[block].push_back(
+                std::vector<uint8_t>(payload, payload + size));
+        });
+
+    decoder_t::factory decoder_factory(max_symbols, max_symbol_size);
+    object_decoder_t object_decoder(decoder_factory, object_size);
+
+    EXPECT_EQ(encoder.encoders(), object_decoder.decoders());
+
+    std::vector<uint8_t> data_out;
+
+    for(uint32_t i = 0; i < object_decoder.decoders(); ++i)
+    {
+        EXPECT_EQ(payloads_per_block, payloads[i].size());
+
+        auto decoder = object_decoder.build(i);
+
+        for(uint32_t j = 0; j < payloads[i].size(); ++j)
+        {
+            decoder->decode(&payloads[i][j][0]);
+        }
+
+        EXPECT_TRUE(decoder->is_complete());
+
+        std::vector<uint8_t> block(decoder->block_size());
+        decoder->copy_symbols(sak::storage(block));
+
+        data_out.insert(data_out.end(), block.begin(),
+                        block.begin() + decoder->bytes_used());
+    }
+
+    EXPECT_EQ(data_in, data_out);
+}
+
+/// Tests that the parallel object decoder decodes the payloads of all
+/// blocks into the object buffer and invokes the callbacks
+TEST(TestObjectCoder, test_parallel_object_decoder)
+{
+    typedef kodo::full_rlnc_encoder<fifi::binary8> encoder_t;
+    typedef kodo::shallow_full_rlnc_decoder<fifi::binary8> decoder_t;
+
+    typedef kodo::object_encoder<
+        kodo::storage_reader<encoder_t>, encoder_t> object_encoder_t;
+
+    typedef kodo::parallel_object_decoder<decoder_t> parallel_decoder_t;
+
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 100;
+
+    // The last block is partial
+    uint32_t object_size = 20 * max_symbols * max_symbol_size + 33;
+    std::vector<uint8_t> data_in = random_vector(object_size);
+
+    encoder_t::factory encoder_factory(max_symbols, max_symbol_size);
+
+    object_encoder_t object_encoder(
+        encoder_factory, kodo::storage_reader<encoder_t>(
+            sak::storage(data_in)));
+
+    decoder_t::factory decoder_factory(max_symbols, max_symbol_size);
+
+    parallel_decoder_t decoder(
+        decoder_factory, object_size,
+        boost::make_shared<kodo::thread_pool>(4));
+
+    EXPECT_EQ(object_encoder.encoders(), decoder.decoders());
+    EXPECT_EQ(object_size, decoder.object_size());
+
+    std::vector<uint32_t> block_completions(decoder.decoders(), 0);
+    uint32_t object_completions = 0;
+
+    decoder.set_block_complete_callback([&](uint32_t block)
+        {
+            // Every block completes exactly once on one thread
+            ++block_completions[block];
+        });
+
+    decoder.set_object_complete_callback([&]()
+        {
+            ++object_completions;
+        });
+
+    std::vector<encoder_t::pointer> encoders;
+
+    for(uint32_t i = 0; i < object_encoder.encoders(); ++i)
+    {
+        encoders.push_back(object_encoder.build(i));
+        kodo::set_systematic_off(encoders.back());
+    }
+
+    std::vector<uint8_t> payload(encoders[0]->payload_size());
+
+    while(!decoder.is_complete())
+    {
+        // Push a burst of payloads interleaved over the blocks
+        for(uint32_t i = 0; i < encoders.size(); ++i)
+        {
+            for(uint32_t j = 0; j < 4; ++j)
+            {
+                uint32_t size = encoders[i]->encode(&payload[0]);
+                decoder.push(i, &payload[0], size);
+            }
+        }
+
+        decoder.run();
+    }
+
+    EXPECT_EQ(decoder.decoders(), decoder.blocks_complete());
+    EXPECT_EQ(1U, object_completions);
+
+    for(uint32_t i = 0; i < decoder.decoders(); ++i)
+    {
+        EXPECT_TRUE(decoder.is_block_complete(i));
+        EXPECT_EQ(1U, block_completions[i]);
+    }
+
+    // Payloads of complete blocks are dropped
+    encoders[0]->encode(&payload[0]);
+    EXPECT_FALSE(decoder.push(0, &payload[0], encoders[0]->payload_size()));
+
+    std::vector<uint8_t> data_out;
+    decoder.swap(data_out);
+
+    EXPECT_EQ(data_in, data_out);
+}
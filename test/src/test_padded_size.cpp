@@ -0,0 +1,34 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_padded_size.cpp Unit tests for the padded_size() function
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <kodo/padded_size.hpp>
+
+/// Tests that sizes are rounded up to a multiple of the buffer alignment
+TEST(TestPaddedSize, test_padded_size)
+{
+    EXPECT_EQ(16U, kodo::buffer_alignment);
+
+    EXPECT_EQ(0U, kodo::padded_size(0));
+    EXPECT_EQ(16U, kodo::padded_size(1));
+    EXPECT_EQ(16U, kodo::padded_size(15));
+    EXPECT_EQ(16U, kodo::padded_size(16));
+    EXPECT_EQ(32U, kodo::padded_size(17));
+    EXPECT_EQ(1408U, kodo::padded_size(1400));
+
+    for(uint32_t size = 0; size < 1000; ++size)
+    {
+        uint32_t padded = kodo::padded_size(size);
+
+        EXPECT_EQ(0U, padded % kodo::buffer_alignment);
+        EXPECT_LE(size, padded);
+        EXPECT_LT(padded - size, kodo::buffer_alignment);
+    }
+}
@@ -0,0 +1,162 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_pivot_bitmap.cpp Unit tests for the kodo::pivot_bitmap
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/field_types.hpp>
+
+#include <kodo/pivot_bitmap.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+/// Checks the bitmap against a plain vector of flags
+inline void test_pivot_bitmap(uint32_t max_size, uint32_t size)
+{
+    kodo::pivot_bitmap bitmap;
+    bitmap.resize(max_size);
+
+    // Dirty the bitmap to check that reset() clears it
+    bitmap.reset(max_size);
+    for(uint32_t i = 0; i < max_size; ++i)
+    {
+        bitmap.set(i);
+    }
+
+    bitmap.reset(size);
+
+    EXPECT_EQ(size, bitmap.size());
+    EXPECT_EQ(0U, bitmap.count());
+    EXPECT_EQ(size, bitmap.find_next(0));
+
+    std::vector<bool> flags(size, false);
+    uint32_t count = 0;
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        if(rand() % 3 == 0)
+        {
+            bitmap.set(i);
+            flags[i] = true;
+            ++count;
+        }
+    }
+
+    // Setting a bit twice should not change the count
+    if(count > 0)
+    {
+        bitmap.set(bitmap.find_next(0));
+    }
+
+    EXPECT_EQ(count, bitmap.count());
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(flags[i], bitmap[i]);
+
+        uint32_t next = i;
+        while(next < size && !flags[next])
+        {
+            ++next;
+        }
+
+        uint32_t next_unset = i;
+        while(next_unset < size && flags[next_unset])
+        {
+            ++next_unset;
+        }
+
+        EXPECT_EQ(next, bitmap.find_next(i));
+        EXPECT_EQ(next_unset, bitmap.find_next_unset(i));
+    }
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        if(flags[i])
+        {
+            bitmap.clear(i);
+            --count;
+        }
+    }
+
+    EXPECT_EQ(0U, count);
+    EXPECT_EQ(0U, bitmap.count());
+    EXPECT_EQ(size, bitmap.find_next(0));
+}
+
+/// Checks that masking a coefficient vector leaves only the
+/// coefficients with a bit set in the bitmap
+template<class Field>
+inline void test_pivot_bitmap_mask(uint32_t size)
+{
+    typedef typename Field::value_type value_type;
+
+    kodo::pivot_bitmap bitmap;
+    bitmap.resize(size);
+    bitmap.reset(size);
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        if(rand() % 2)
+        {
+            bitmap.set(i);
+        }
+    }
+
+    uint32_t length = fifi::elements_to_length<Field>(size);
+
+    std::vector<value_type> vector(length);
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        vector[i] = rand() % 200;
+    }
+
+    std::vector<value_type> original = vector;
+
+    bitmap.mask<Field>(&vector[0]);
+
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        if(bitmap[i])
+        {
+            EXPECT_EQ(fifi::get_value<Field>(&original[0], i),
+                      fifi::get_value<Field>(&vector[0], i));
+        }
+        else
+        {
+            EXPECT_EQ(0U, fifi::get_value<Field>(&vector[0], i));
+        }
+    }
+}
+
+/// Tests the basic functionality of the bitmap
+TEST(TestPivotBitmap, test_pivot_bitmap)
+{
+    test_pivot_bitmap(1, 1);
+    test_pivot_bitmap(64, 64);
+    test_pivot_bitmap(200, 65);
+    test_pivot_bitmap(200, 200);
+
+    uint32_t size = rand_symbols(1000);
+    test_pivot_bitmap(size, size);
+}
+
+/// Tests masking coefficient vectors
+TEST(TestPivotBitmap, test_mask)
+{
+    uint32_t size = rand_symbols(1000);
+
+    test_pivot_bitmap_mask<fifi::binary>(size);
+    test_pivot_bitmap_mask<fifi::binary8>(size);
+    test_pivot_bitmap_mask<fifi::binary16>(size);
+
+    test_pivot_bitmap_mask<fifi::binary>(130);
+    test_pivot_bitmap_mask<fifi::binary8>(130);
+}
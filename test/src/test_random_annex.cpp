@@ -48,7 +48,7 @@ inline void invoke_max_annex_size(uint32_t max_symbols,
 
     for(uint32_t i = 0; i < scheme.blocks(); ++i)
     {
-        uint32_t remaining_symbols =
+        uint64_t remaining_symbols =
             scheme.total_symbols() - scheme.symbols(i);
 
         ASSERT_TRUE(remaining_symbols >= max_annex);
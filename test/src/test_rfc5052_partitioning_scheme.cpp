@@ -86,3 +86,40 @@ TEST(TestRfc5052PartitioningScheme, partition_size)
     }
 }
 
+TEST(TestRfc5052PartitioningScheme, partition_large_object)
+{
+    // An object larger than 4 GB, the blocks must cover the object
+    // exactly without gaps or overlap
+    uint32_t max_symbols = 64;
+    uint32_t max_symbol_size = 1500;
+    uint64_t object_size = 10ULL * 1024 * 1024 * 1024 + 12345;
+
+    kodo::rfc5052_partitioning_scheme partitioning(
+        max_symbols, max_symbol_size, object_size);
+
+    EXPECT_EQ(object_size, partitioning.object_size());
+    EXPECT_EQ(((object_size - 1) / max_symbol_size) + 1,
+              partitioning.total_symbols());
+    EXPECT_EQ(partitioning.total_symbols() * max_symbol_size,
+              partitioning.total_block_size());
+
+    uint64_t offset = 0;
+    uint64_t total_symbols = 0;
+
+    for(uint32_t i = 0; i < partitioning.blocks(); ++i)
+    {
+        ASSERT_EQ(offset, partitioning.byte_offset(i));
+        ASSERT_TRUE(partitioning.symbols(i) <= max_symbols);
+
+        offset += partitioning.block_size(i);
+        total_symbols += partitioning.symbols(i);
+    }
+
+    EXPECT_EQ(partitioning.total_symbols(), total_symbols);
+
+    uint32_t last = partitioning.blocks() - 1;
+
+    EXPECT_EQ(object_size, partitioning.byte_offset(last) +
+              partitioning.bytes_used(last));
+}
+
@@ -20,6 +20,7 @@
 #include <kodo/storage_aware_generator.hpp>
 #include <kodo/shallow_symbol_storage.hpp>
 #include <kodo/has_shallow_symbol_storage.hpp>
+#include <kodo/thread_pool.hpp>
 
 #include "basic_api_test_helper.hpp"
 
@@ -114,7 +115,6 @@ namespace kodo
                  uniform_generator<
                  // Codec API
                  encode_symbol_tracker<
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  storage_aware_encoder<
                  // Coefficient Storage API
@@ -130,7 +130,7 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  full_rlnc_encoder_shallow<Field>
-                     > > > > > > > > > > > > > > > > >
+                     > > > > > > > > > > > > > > > >
     { };
 
 
@@ -230,5 +230,48 @@ TEST(TestRlncFullVectorCodes, test_reuse_incomplete_api)
         kodo::full_rlnc_decoder_delayed>();
 }
 
+/// Encodes and decodes with a delayed decoder which splits the final
+/// backward substitution between the threads of a pool
+template<class Field>
+inline void test_delayed_thread_pool(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef kodo::full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::full_rlnc_decoder_delayed<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+
+    auto encoder = encoder_factory.build();
+    auto decoder = decoder_factory.build();
+
+    decoder->set_thread_pool(boost::make_shared<kodo::thread_pool>(3));
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    kodo::set_systematic_off(encoder);
 
+    std::vector<uint8_t> payload(encoder->payload_size());
 
+    while(!decoder->is_complete())
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    std::vector<uint8_t> data_out(decoder->block_size());
+    decoder->copy_symbols(sak::storage(data_out));
+
+    EXPECT_TRUE(data_in == data_out);
+}
+
+/// Tests the delayed decoder with a thread pool for the different fields
+TEST(TestRlncFullVectorCodes, test_delayed_thread_pool)
+{
+    test_delayed_thread_pool<fifi::binary>(32, 20000);
+    test_delayed_thread_pool<fifi::binary8>(32, 20000);
+    test_delayed_thread_pool<fifi::binary16>(32, 20000);
+
+    // Symbols too small to be split
+    test_delayed_thread_pool<fifi::binary8>(16, 100);
+}
@@ -4,9 +4,11 @@
 // http://www.steinwurf.com/licensing
 
 #include <ctime>
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 #include <kodo/rlnc/seed_codes.hpp>
+#include <kodo/systematic_operations.hpp>
 
 #include "basic_api_test_helper.hpp"
 
@@ -62,6 +64,178 @@ TEST(TestSeedcodes, test_reuse_incomplete_api)
     test_reuse_incomplete<kodo::seed_rlnc_encoder, kodo::seed_rlnc_decoder>();
 }
 
+/// Tests the basic API functionality of the seed codes using the
+/// splitmix64 generator
+TEST(TestSeedCodes, test_fast_basic_api)
+{
+    test_basic_api<kodo::fast_seed_rlnc_encoder,
+                   kodo::fast_seed_rlnc_decoder>();
+}
+
+/// Tests the initialize() functionality of the seed codes using the
+/// splitmix64 generator
+TEST(TestSeedCodes, test_fast_initialize_api)
+{
+    test_initialize<kodo::fast_seed_rlnc_encoder,
+                    kodo::fast_seed_rlnc_decoder>();
+}
 
+/// Tests systematic packets with the seed codes using the splitmix64
+/// generator
+TEST(TestSeedCodes, test_fast_systematic_api)
+{
+    test_systematic<kodo::fast_seed_rlnc_encoder,
+                    kodo::fast_seed_rlnc_decoder>();
+}
 
+/// Tests that a decoder drops the coded symbols of an encoder using a
+/// different version of the generator
+template<class Encoder, class Decoder>
+inline void test_seed_version_mismatch()
+{
+    uint32_t symbols = 16;
+    uint32_t symbol_size = 100;
 
+    typename Encoder::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename Decoder::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    kodo::set_systematic_off(encoder);
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    for(uint32_t i = 0; i < 2 * symbols; ++i)
+    {
+        encoder->encode(&payload[0]);
+        decoder->decode(&payload[0]);
+    }
+
+    EXPECT_EQ(0U, decoder->rank());
+}
+
+TEST(TestSeedCodes, test_seed_version_mismatch)
+{
+    test_seed_version_mismatch<
+        kodo::seed_rlnc_encoder<fifi::binary8>,
+        kodo::fast_seed_rlnc_decoder<fifi::binary8> >();
+
+    test_seed_version_mismatch<
+        kodo::fast_seed_rlnc_encoder<fifi::binary>,
+        kodo::seed_rlnc_decoder<fifi::binary> >();
+}
+
+/// Tests that the encoder refuses to write more symbol ids than it has
+/// seeds, since they would repeat earlier coefficient vectors
+TEST(TestSeedCodes, test_seed_limit)
+{
+    typedef kodo::fast_seed_rlnc_encoder<fifi::binary8> encoder_t;
+
+    encoder_t::factory encoder_factory(1, 10);
+    auto encoder = encoder_factory.build();
+
+    std::vector<uint8_t> symbol_id(encoder->id_size());
+    uint8_t *coefficients = 0;
+
+    // The ids written without encoding count towards the seeds used
+    for(uint32_t i = 0; i <= encoder_t::max_seed; ++i)
+    {
+        encoder->write_id(&symbol_id[0], &coefficients);
+    }
+
+    EXPECT_FALSE(encoder->has_seed());
+    EXPECT_THROW(encoder->write_id(&symbol_id[0], &coefficients),
+                 std::out_of_range);
+}
+
+/// Tests the basic API of the decoder caching the encoding vectors
+TEST(TestSeedCodes, test_cached_basic_api)
+{
+    test_basic_api<kodo::seed_rlnc_encoder,
+                   kodo::cached_seed_rlnc_decoder>();
+}
+
+/// Tests that the cached decoders can be reset and reused
+TEST(TestSeedCodes, test_cached_initialize_api)
+{
+    test_initialize<kodo::seed_rlnc_encoder,
+                    kodo::cached_seed_rlnc_decoder>();
+}
+
+/// Tests that the cached decoders handle systematic symbols
+TEST(TestSeedCodes, test_cached_systematic_api)
+{
+    test_systematic<kodo::seed_rlnc_encoder,
+                    kodo::cached_seed_rlnc_decoder>();
+}
+
+/// Checks that decoders built from the same factory share the cached
+/// encoding vectors and still decode the data correctly
+template<class Field>
+inline void test_cached_duplicates(uint32_t symbols, uint32_t symbol_size)
+{
+    typedef kodo::seed_rlnc_encoder<Field> encoder_type;
+    typedef kodo::cached_seed_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    decoder_factory.seed_cache()->set_capacity(4 * symbols);
+
+    auto first = decoder_factory.build();
+    auto second = decoder_factory.build();
+
+    EXPECT_EQ(first->seed_cache(), second->seed_cache());
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+
+    kodo::set_systematic_off(encoder);
+
+    std::vector<std::vector<uint8_t> > payloads;
+
+    while(!first->is_complete())
+    {
+        std::vector<uint8_t> payload(encoder->payload_size());
+        encoder->encode(&payload[0]);
+
+        // The decoders work on the payload so we keep a copy
+        payloads.push_back(payload);
+        first->decode(&payload[0]);
+    }
+
+    auto cache = decoder_factory.seed_cache();
+
+    EXPECT_EQ(0U, cache->hits());
+    EXPECT_EQ(payloads.size(), cache->misses());
+
+    for(uint32_t i = 0; i < payloads.size(); ++i)
+    {
+        second->decode(&payloads[i][0]);
+    }
+
+    EXPECT_TRUE(second->is_complete());
+    EXPECT_EQ(payloads.size(), cache->hits());
+
+    std::vector<uint8_t> data_out(first->block_size(), 0);
+
+    first->copy_symbols(sak::storage(data_out));
+    EXPECT_TRUE(std::equal(data_out.begin(), data_out.end(),
+                           data_in.begin()));
+
+    second->copy_symbols(sak::storage(data_out));
+    EXPECT_TRUE(std::equal(data_out.begin(), data_out.end(),
+                           data_in.begin()));
+}
+
+TEST(TestSeedCodes, test_cached_duplicates)
+{
+    test_cached_duplicates<fifi::binary>(32, 64);
+    test_cached_duplicates<fifi::binary8>(16, 100);
+    test_cached_duplicates<fifi::binary16>(10, 100);
+}
@@ -0,0 +1,93 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_rlnc_sparse_full_vector_codes.cpp Unit tests for the
+///       sparse full vector RLNC codes
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/rlnc/sparse_full_vector_codes.hpp>
+#include <kodo/systematic_operations.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+#include "helper_test_basic_api.hpp"
+#include "helper_test_initialize_api.hpp"
+#include "helper_test_systematic_api.hpp"
+
+/// Tests the basic API functionality this mean basic encoding
+/// and decoding
+TEST(TestRlncSparseFullVectorCodes, test_basic_api)
+{
+    test_basic_api<kodo::sparse_full_rlnc_encoder,
+                   kodo::sparse_full_rlnc_decoder>();
+}
+
+/// Test that the encoders and decoders initialize() function can be used
+/// to reset the state of an encoder and decoder and that they therefore
+/// can be safely reused.
+TEST(TestRlncSparseFullVectorCodes, test_initialize)
+{
+    test_initialize<kodo::sparse_full_rlnc_encoder,
+                    kodo::sparse_full_rlnc_decoder>();
+}
+
+/// Tests that an encoder producing systematic packets is handled
+/// correctly in the decoder.
+TEST(TestRlncSparseFullVectorCodes, test_systematic)
+{
+    test_systematic<kodo::sparse_full_rlnc_encoder,
+                    kodo::sparse_full_rlnc_decoder>();
+}
+
+/// Checks the number of bytes used by the coded payloads at a given
+/// density and that the decoder reads the coefficients correctly. The
+/// header includes the flag of the systematic encoder.
+template<class Field>
+inline void test_sparse_header_size(uint32_t symbols, uint32_t symbol_size,
+                                    double density, uint32_t max_header)
+{
+    typedef kodo::sparse_full_rlnc_encoder<Field> encoder_type;
+    typedef kodo::sparse_full_rlnc_decoder<Field> decoder_type;
+
+    typename encoder_type::factory encoder_factory(symbols, symbol_size);
+    auto encoder = encoder_factory.build();
+
+    typename decoder_type::factory decoder_factory(symbols, symbol_size);
+    auto decoder = decoder_factory.build();
+
+    std::vector<uint8_t> data_in = random_vector(encoder->block_size());
+    encoder->set_symbols(sak::storage(data_in));
+    encoder->set_density(density);
+
+    kodo::set_systematic_off(encoder);
+
+    std::vector<uint8_t> payload(encoder->payload_size());
+
+    for(uint32_t i = 0; i < 10; ++i)
+    {
+        uint32_t bytes_used = encoder->encode(&payload[0]);
+
+        EXPECT_LE(bytes_used, symbol_size + max_header);
+
+        decoder->decode(&payload[0]);
+    }
+
+    EXPECT_GT(decoder->rank(), 0U);
+}
+
+TEST(TestRlncSparseFullVectorCodes, test_header_size)
+{
+    // Around 20 non-zero coefficients of one position and one value
+    // byte each plus the format byte and the count
+    test_sparse_header_size<fifi::binary8>(2048, 1400, 0.01, 100);
+    test_sparse_header_size<fifi::binary>(2048, 1400, 0.01, 100);
+
+    // At full density the dense format is used
+    test_sparse_header_size<fifi::binary8>(2048, 1400, 1.0, 2 + 2048);
+}
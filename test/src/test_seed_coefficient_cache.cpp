@@ -0,0 +1,74 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_seed_coefficient_cache.cpp Unit tests for the cache of
+///       regenerated coefficient vectors
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/seed_coefficient_cache.hpp>
+
+/// Tests that vectors are found and that the least recently used
+/// vector is evicted when the cache is full
+TEST(TestSeedCoefficientCache, test_lru)
+{
+    kodo::seed_coefficient_cache cache(2);
+
+    std::vector<uint8_t> a(10, 'a');
+    std::vector<uint8_t> b(10, 'b');
+    std::vector<uint8_t> c(10, 'c');
+    std::vector<uint8_t> out(10, 0);
+
+    EXPECT_FALSE(cache.find(1, &out[0], 10));
+
+    cache.insert(1, &a[0], 10);
+    cache.insert(2, &b[0], 10);
+    EXPECT_EQ(2U, cache.size());
+
+    // Touch the first vector so the second one is evicted
+    EXPECT_TRUE(cache.find(1, &out[0], 10));
+    EXPECT_EQ(a, out);
+
+    cache.insert(3, &c[0], 10);
+    EXPECT_EQ(2U, cache.size());
+
+    EXPECT_FALSE(cache.find(2, &out[0], 10));
+    EXPECT_TRUE(cache.find(3, &out[0], 10));
+    EXPECT_EQ(c, out);
+    EXPECT_TRUE(cache.find(1, &out[0], 10));
+    EXPECT_EQ(a, out);
+
+    // A lookup with a different size is a miss
+    EXPECT_FALSE(cache.find(1, &out[0], 5));
+
+    EXPECT_EQ(3U, cache.hits());
+    EXPECT_EQ(3U, cache.misses());
+
+    cache.set_capacity(1);
+    EXPECT_EQ(1U, cache.size());
+    EXPECT_TRUE(cache.find(1, &out[0], 10));
+
+    cache.clear();
+    EXPECT_EQ(0U, cache.size());
+    EXPECT_EQ(0U, cache.hits());
+    EXPECT_EQ(0U, cache.misses());
+}
+
+/// Tests that a cache with zero capacity stores nothing
+TEST(TestSeedCoefficientCache, test_disabled)
+{
+    kodo::seed_coefficient_cache cache(0);
+
+    std::vector<uint8_t> a(10, 'a');
+    std::vector<uint8_t> out(10, 0);
+
+    cache.insert(1, &a[0], 10);
+
+    EXPECT_EQ(0U, cache.size());
+    EXPECT_FALSE(cache.find(1, &out[0], 10));
+}
@@ -5,10 +5,17 @@
 
 /// @file test_storage_xyz.cpp Unit tests for storage encoder and decoders
 
+#include <cstdint>
 #include <ctime>
 
 #include <gtest/gtest.h>
 
+#include <kodo/posix_file_api.hpp>
+
+#if defined(KODO_POSIX_FILE_API)
+    #include <sys/mman.h>
+#endif
+
 #include <kodo/shallow_storage_decoder.hpp>
 #include <kodo/deep_storage_decoder.hpp>
 #include <kodo/storage_encoder.hpp>
@@ -79,7 +86,7 @@ void invoke_shallow_decoder(uint32_t max_symbols,
         max_symbols, max_symbol_size);
 
     // The storage needed for all decoders
-    uint32_t total_block_size =
+    uint64_t total_block_size =
         decoder_factory.total_block_size(object_size);
 
     std::vector<uint8_t> data_out(total_block_size, '\0');
@@ -267,13 +274,101 @@ TEST(TestStorageCoder, deep_storage_decoder)
     test_deep_decoder(symbols, symbol_size, object_size);
 }
 
+#if defined(KODO_POSIX_FILE_API) && (UINTPTR_MAX > 0xffffffffU)
+
+/// Maps a zero initialized buffer which is only backed by memory where
+/// it is written to, so objects larger than 4 GB can be tested
+/// @param size The size of the buffer in bytes
+/// @return The buffer or 0 if it could not be mapped
+inline uint8_t* map_sparse_buffer(uint64_t size)
+{
+    void *data = mmap(0, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    return data == MAP_FAILED ? 0 : static_cast<uint8_t*>(data);
+}
+
+/// Tests that the blocks of an object larger than 4 GB are read from and
+/// decoded into the correct part of the object
+TEST(TestStorageCoder, storage_offsets_above_4gb)
+{
+    typedef kodo::storage_encoder<kodo::full_rlnc_encoder<fifi::binary8> >
+        storage_encoder;
+
+    typedef kodo::shallow_storage_decoder<
+        kodo::shallow_rlnc_decoder<fifi::binary8> > storage_decoder;
+
+    uint32_t max_symbols = 16;
+    uint32_t max_symbol_size = 1024;
+
+    // The last block is partial
+    uint64_t object_size = (uint64_t(1) << 32) + 5003;
 
+    storage_encoder::factory encoder_factory(max_symbols, max_symbol_size);
+    storage_decoder::factory decoder_factory(max_symbols, max_symbol_size);
 
+    uint64_t total_block_size =
+        decoder_factory.total_block_size(object_size);
 
+    uint8_t *data_in = map_sparse_buffer(object_size);
+    uint8_t *data_out = map_sparse_buffer(total_block_size);
 
+    if(data_in == 0 || data_out == 0)
+    {
+        // Not enough address space, nothing to test
+        if(data_in != 0) munmap(data_in, object_size);
+        if(data_out != 0) munmap(data_out, total_block_size);
+        return;
+    }
 
+    {
+        storage_encoder encoder(encoder_factory, data_in, object_size);
+        storage_decoder decoder(
+            decoder_factory, object_size, data_out, total_block_size);
 
+        EXPECT_EQ(object_size, encoder.object_size());
+        EXPECT_EQ(encoder.encoders(), decoder.decoders());
 
+        // The last two blocks lie above 4 GB
+        uint32_t blocks = encoder.encoders();
+        ASSERT_GE(blocks, 2U);
 
+        kodo::rfc5052_partitioning_scheme partitioning(
+            max_symbols, max_symbol_size, object_size);
 
+        uint64_t first_offset = partitioning.byte_offset(blocks - 2);
+
+        ASSERT_GT(first_offset, uint64_t(1) << 32);
+
+        std::vector<uint8_t> tail =
+            random_vector(uint32_t(object_size - first_offset));
+
+        std::copy(tail.begin(), tail.end(), data_in + first_offset);
+
+        for(uint32_t i = blocks - 2; i < blocks; ++i)
+        {
+            auto e = encoder.build(i);
+            auto d = decoder.build(i);
+
+            kodo::set_systematic_off(e);
+
+            EXPECT_EQ(e->bytes_used(), d->bytes_used());
+
+            std::vector<uint8_t> payload(e->payload_size());
+
+            while(!d->is_complete())
+            {
+                e->encode(&payload[0]);
+                d->decode(&payload[0]);
+            }
+        }
+
+        EXPECT_TRUE(std::equal(tail.begin(), tail.end(),
+                               data_out + first_offset));
+    }
+
+    munmap(data_in, object_size);
+    munmap(data_out, total_block_size);
+}
 
+#endif
@@ -0,0 +1,140 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_striped_finite_field_math.cpp Unit tests for the
+///       kodo::striped_finite_field_math layer
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fifi/default_field.hpp>
+#include <fifi/fifi_utils.hpp>
+
+#include <kodo/final_coder_factory_pool.hpp>
+#include <kodo/finite_field_info.hpp>
+#include <kodo/finite_field_math.hpp>
+#include <kodo/storage_block_info.hpp>
+#include <kodo/striped_finite_field_math.hpp>
+#include <kodo/thread_pool.hpp>
+
+#include "basic_api_test_helper.hpp"
+
+namespace kodo
+{
+
+    /// Finite field stack without striping used as reference
+    template<class Field>
+    class reference_math_stack
+        : public storage_block_info<
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 final_coder_factory_pool<
+                 reference_math_stack<Field>
+                     > > > >
+    { };
+
+    /// Finite field stack with striping
+    template<class Field>
+    class striped_math_stack
+        : public storage_block_info<
+                 striped_finite_field_math<
+                 finite_field_math<typename fifi::default_field<Field>::type,
+                 finite_field_info<Field,
+                 final_coder_factory_pool<
+                 striped_math_stack<Field>
+                     > > > > >
+    { };
+
+}
+
+/// Applies every operation to the same buffers with and without the
+/// striping and checks that the results match
+template<class Field>
+inline void test_striped_math(uint32_t symbol_size, uint32_t threads)
+{
+    typedef typename Field::value_type value_type;
+
+    typename kodo::reference_math_stack<Field>::factory
+        reference_factory(2, symbol_size);
+
+    typename kodo::striped_math_stack<Field>::factory
+        striped_factory(2, symbol_size);
+
+    auto reference = reference_factory.build();
+    auto striped = striped_factory.build();
+
+    if(threads > 0)
+    {
+        striped->set_math_thread_pool(
+            boost::make_shared<kodo::thread_pool>(threads));
+    }
+
+    uint32_t length = fifi::size_to_length<Field>(symbol_size);
+
+    std::vector<uint8_t> source = random_vector(symbol_size);
+    std::vector<uint8_t> expected = random_vector(symbol_size);
+    std::vector<uint8_t> result = expected;
+
+    const value_type *src =
+        reinterpret_cast<const value_type*>(&source[0]);
+    value_type *dest_expected =
+        reinterpret_cast<value_type*>(&expected[0]);
+    value_type *dest_result =
+        reinterpret_cast<value_type*>(&result[0]);
+
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        // Avoid the illegal 0xffffffff value of the prime2325 field
+        value_type coefficient = rand_nonzero(200);
+
+        if(fifi::is_binary<Field>::value)
+        {
+            coefficient = 1U;
+        }
+
+        reference->multiply_add(dest_expected, src, coefficient, length);
+        striped->multiply_add(dest_result, src, coefficient, length);
+        EXPECT_TRUE(expected == result);
+
+        reference->multiply_subtract(dest_expected, src, coefficient, length);
+        striped->multiply_subtract(dest_result, src, coefficient, length);
+        EXPECT_TRUE(expected == result);
+
+        reference->add(dest_expected, src, length);
+        striped->add(dest_result, src, length);
+        EXPECT_TRUE(expected == result);
+
+        reference->subtract(dest_expected, src, length);
+        striped->subtract(dest_result, src, length);
+        EXPECT_TRUE(expected == result);
+
+        reference->multiply(dest_expected, coefficient, length);
+        striped->multiply(dest_result, coefficient, length);
+        EXPECT_TRUE(expected == result);
+    }
+}
+
+template<class Field>
+inline void test_striped_math()
+{
+    // Without a pool and with buffers too small to split
+    test_striped_math<Field>(65536, 0);
+    test_striped_math<Field>(1600, 4);
+
+    // Split into stripes where the last stripe is shorter
+    test_striped_math<Field>(65536, 4);
+    test_striped_math<Field>(100004, 3);
+}
+
+/// Tests that the striped operations give the same result as the
+/// operations on the full buffers
+TEST(TestStripedFiniteFieldMath, test_operations)
+{
+    test_striped_math<fifi::binary>();
+    test_striped_math<fifi::binary8>();
+    test_striped_math<fifi::binary16>();
+}
@@ -6,6 +6,7 @@
 /// @file test_symbol_id.cpp Unit tests for the Symbol ID API
 
 #include <cstdint>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -16,6 +17,9 @@
 #include <kodo/plain_symbol_id_reader.hpp>
 #include <kodo/plain_symbol_id_writer.hpp>
 #include <kodo/uniform_generator.hpp>
+#include <kodo/geometric_sparse_generator.hpp>
+#include <kodo/sparse_symbol_id_reader.hpp>
+#include <kodo/sparse_symbol_id_writer.hpp>
 #include <kodo/coefficient_storage.hpp>
 #include <kodo/coefficient_info.hpp>
 #include <kodo/storage_block_info.hpp>
@@ -45,6 +49,19 @@ namespace kodo
                      > > > > > > >
     { };
 
+    template<class Field>
+    class sparse_geometric_stack
+        : public sparse_symbol_id_reader<
+                 sparse_symbol_id_writer<
+                 geometric_sparse_generator<
+                 coefficient_info<
+                 storage_block_info<
+                 finite_field_info<Field,
+                 final_coder_factory<
+                 sparse_geometric_stack<Field>
+                     > > > > > > >
+    { };
+
     template<class Field>
     class rs_vandermond_nonsystematic_stack
         : public reed_solomon_symbol_id_reader<
@@ -159,6 +176,91 @@ TEST(TestSymbolId, test_plain_stack)
 }
 
 
+/// Run the tests on the sparse symbol id stack, at the default density
+/// of the generator both formats are used
+TEST(TestSymbolId, test_sparse_stack)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    // API tests:
+    run_test<kodo::sparse_geometric_stack, api_symbol_id>(
+        symbols, symbol_size);
+}
+
+/// Reads a sparse symbol id and checks the coefficients
+/// @param coder The coder reading the symbol id
+/// @param id The symbol id, padded to the id size of the coder
+/// @param expected The expected coefficients
+template<class Coder>
+inline void check_sparse_id(Coder &coder, std::vector<uint8_t> id,
+                            const std::vector<uint8_t> &expected)
+{
+    id.resize(coder->id_size(), 0);
+
+    uint8_t *coefficients = 0;
+    coder->read_id(&id[0], &coefficients);
+
+    ASSERT_TRUE(coefficients != 0);
+
+    std::vector<uint8_t> actual(
+        coefficients, coefficients + coder->coefficients_size());
+
+    EXPECT_EQ(expected, actual);
+}
+
+/// Tests that the sparse symbol id reader gives malformed symbol ids
+/// zero coefficients
+TEST(TestSymbolId, test_sparse_malformed)
+{
+    typedef kodo::sparse_geometric_stack<fifi::binary8> stack_type;
+
+    uint32_t symbols = 16;
+    stack_type::factory factory(symbols, 10);
+    auto coder = factory.build();
+
+    std::vector<uint8_t> zero(symbols, 0);
+
+    // Positions 3 and 5 with the values 7 and 9
+    std::vector<uint8_t> expected(zero);
+    expected[3] = 7;
+    expected[5] = 9;
+
+    uint8_t valid[] = { 1, 2, 3, 7, 2, 9 };
+    check_sparse_id(coder, std::vector<uint8_t>(valid, valid + 6), expected);
+
+    // Unknown format
+    uint8_t format[] = { 2, 2, 3, 7, 2, 9 };
+    check_sparse_id(coder, std::vector<uint8_t>(format, format + 6), zero);
+
+    // More entries than symbols
+    uint8_t count[] = { 1, 17, 0, 1 };
+    check_sparse_id(coder, std::vector<uint8_t>(count, count + 4), zero);
+
+    // A position past the last symbol
+    uint8_t position[] = { 1, 2, 3, 7, 13, 9 };
+    check_sparse_id(
+        coder, std::vector<uint8_t>(position, position + 6), zero);
+
+    // A variable length integer longer than 5 bytes
+    uint8_t varint[] = { 1, 0x81, 0x80, 0x80, 0x80, 0x80, 0x00 };
+    check_sparse_id(coder, std::vector<uint8_t>(varint, varint + 7), zero);
+
+    // A variable length integer overflowing 32 bits
+    uint8_t overflow[] = { 1, 0x81, 0x80, 0x80, 0x80, 0x10 };
+    check_sparse_id(
+        coder, std::vector<uint8_t>(overflow, overflow + 6), zero);
+
+    // Entries running past the end of the symbol id
+    std::vector<uint8_t> truncated(coder->id_size(), 1);
+    truncated[0] = 1;
+    truncated[1] = 16;
+    check_sparse_id(coder, truncated, zero);
+
+    // The reader still works after the malformed ids
+    check_sparse_id(coder, std::vector<uint8_t>(valid, valid + 6), expected);
+}
+
 /// Run the tests typical coefficients stack
 TEST(TestSymbolId, test_rs_stack)
 {
@@ -1859,3 +1859,42 @@ TEST(TestSymbolStorage, test_has_deep_symbol_storage)
 
 
 
+
+/// Tests that a recycled deep storage is cleared for the block in use
+/// also when the previous block was larger
+TEST(TestSymbolStorage, test_deep_storage_recycled)
+{
+    typedef kodo::deep_storage_stack_pool<fifi::binary8> coder_type;
+
+    uint32_t max_symbols = 32;
+    uint32_t max_symbol_size = 64;
+
+    coder_type::factory factory(max_symbols, max_symbol_size);
+
+    {
+        auto coder = factory.build();
+
+        std::vector<uint8_t> data = random_vector(coder->block_size());
+        coder->set_symbols(sak::storage(data));
+
+        EXPECT_EQ(max_symbols, coder->symbols_initialized());
+    }
+
+    factory.set_symbols(5);
+    factory.set_symbol_size(40);
+
+    auto coder = factory.build();
+    EXPECT_EQ(0U, coder->symbols_initialized());
+
+    for(uint32_t i = 0; i < coder->symbols(); ++i)
+    {
+        EXPECT_FALSE(coder->is_symbol_initialized(i));
+
+        const uint8_t *symbol = coder->symbol(i);
+
+        for(uint32_t j = 0; j < coder->symbol_size(); ++j)
+        {
+            EXPECT_EQ(0U, symbol[j]);
+        }
+    }
+}
@@ -24,7 +24,6 @@ namespace kodo
                  // Coefficient Generator API
                  uniform_generator<
                  // Codec API
-                 zero_symbol_encoder<
                  linear_block_encoder<
                  // Coefficient Storage API
                  coefficient_info<
@@ -39,7 +38,7 @@ namespace kodo
                  final_coder_factory_pool<
                  // Final type
                  test_nonsystematic_stack<Field>
-                     > > > > > > > > > > > > >
+                     > > > > > > > > > > > >
     { };
 
 }
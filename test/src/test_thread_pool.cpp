@@ -0,0 +1,139 @@
+// Copyright Steinwurf ApS 2011-2013.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+/// @file test_thread_pool.cpp Unit tests for the kodo::thread_pool
+
+#include <cstdint>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kodo/thread_pool.hpp>
+
+/// Runs a number of tasks and checks that each is executed exactly once
+inline void run_tasks(kodo::thread_pool &pool, uint32_t tasks)
+{
+    std::vector<std::atomic<uint32_t> > executed(tasks);
+
+    for(uint32_t i = 0; i < tasks; ++i)
+    {
+        executed[i] = 0;
+    }
+
+    pool.run(tasks, [&](uint32_t task)
+    {
+        ++executed[task];
+    });
+
+    for(uint32_t i = 0; i < tasks; ++i)
+    {
+        EXPECT_EQ(1U, executed[i]);
+    }
+}
+
+/// Tests that all tasks of a run are executed once
+TEST(TestThreadPool, test_run)
+{
+    {
+        kodo::thread_pool pool(1);
+        EXPECT_EQ(1U, pool.threads());
+
+        run_tasks(pool, 0);
+        run_tasks(pool, 1);
+        run_tasks(pool, 10);
+    }
+
+    {
+        kodo::thread_pool pool(4);
+        EXPECT_EQ(4U, pool.threads());
+
+        // The pool is reused across runs
+        for(uint32_t i = 0; i < 100; ++i)
+        {
+            run_tasks(pool, i % 20);
+        }
+
+        run_tasks(pool, 1000);
+    }
+}
+
+/// Tests that a pool can be shared by several threads calling run()
+TEST(TestThreadPool, test_shared)
+{
+    kodo::thread_pool pool(3);
+
+    std::vector<std::thread> callers;
+
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        callers.push_back(std::thread([&pool]()
+        {
+            for(uint32_t k = 0; k < 50; ++k)
+            {
+                run_tasks(pool, 7);
+            }
+        }));
+    }
+
+    for(uint32_t i = 0; i < callers.size(); ++i)
+    {
+        callers[i].join();
+    }
+}
+
+/// Tests that a run started from within a task completes
+TEST(TestThreadPool, test_nested)
+{
+    kodo::thread_pool pool(4);
+
+    std::atomic<uint32_t> executed(0);
+
+    pool.run(8, [&](uint32_t)
+    {
+        pool.run(8, [&](uint32_t)
+        {
+            ++executed;
+        });
+    });
+
+    EXPECT_EQ(64U, executed);
+}
+
+/// Tests that an exception thrown by a task is rethrown by run() and
+/// that the pool can be used again afterwards
+TEST(TestThreadPool, test_exception)
+{
+    for(uint32_t threads = 1; threads <= 4; ++threads)
+    {
+        kodo::thread_pool pool(threads);
+
+        std::atomic<uint32_t> executed(0);
+
+        EXPECT_THROW(pool.run(100, [&](uint32_t task)
+        {
+            ++executed;
+
+            if(task % 10 == 3)
+            {
+                throw std::runtime_error("task failed");
+            }
+        }), std::runtime_error);
+
+        EXPECT_GE(executed, 1U);
+        EXPECT_LE(executed, 100U);
+
+        executed = 0;
+
+        pool.run(100, [&](uint32_t)
+        {
+            ++executed;
+        });
+
+        EXPECT_EQ(100U, executed);
+    }
+}
@@ -38,6 +38,20 @@ namespace kodo
                > > > > > > >
     { };
 
+    // Uniform generator using the xoshiro256 generator
+    template<class Field>
+    class fast_uniform_generator_stack_pool :
+        public fast_uniform_generator<
+               fake_codec_layer<
+               coefficient_info<
+               fake_symbol_storage<
+               storage_block_info<
+               finite_field_info<Field,
+               final_coder_factory_pool<
+               fast_uniform_generator_stack_pool<Field>
+               > > > > > > >
+    { };
+
 }
 
 /// Run the tests typical coefficients stack
@@ -56,3 +70,14 @@ TEST(TestCoefficientGenerator, test_uniform_generator_stack)
         api_generate>(symbols, symbol_size);
 }
 
+/// Run the tests on the stack using the xoshiro256 generator
+TEST(TestCoefficientGenerator, test_fast_uniform_generator_stack)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    // API tests:
+    run_test<
+        kodo::fast_uniform_generator_stack_pool,
+        api_generate>(symbols, symbol_size);
+}